@@ -0,0 +1,167 @@
+/**
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "Baseline.h"
+
+#include "BinaryIO.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace {
+    const char MAGIC[8] = { 'D', 'U', 'P', 'L', 'O', 'B', 'L', 0 };
+}
+
+Baseline::Baseline(const std::string& settings, const std::string& cacheSettings) :
+    m_settings(settings),
+    m_files("", cacheSettings)
+{
+}
+
+bool Baseline::load(const std::string& fileName){
+    std::ifstream in(fileName.c_str(), std::ios::in|std::ios::binary);
+    if(!in.is_open()){
+        return false;
+    }
+
+    const unsigned long long bytesLeft = BinaryIO::getBytesLeft(in);
+
+    char magic[sizeof(MAGIC)];
+    unsigned int version;
+    std::string settings;
+    if(!in.read(magic, sizeof(magic)) || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+       !BinaryIO::readValue(in, version) || version != BASELINE_VERSION ||
+       !BinaryIO::readString(in, settings, bytesLeft) || settings != m_settings ||
+       !BinaryIO::readValue(in, m_stopLinesHigh) || !BinaryIO::readValue(in, m_stopLinesLow) ||
+       !m_files.read(in)){
+        return false;
+    }
+
+    unsigned int numFiles;
+    if(!BinaryIO::readValue(in, numFiles)){
+        return false;
+    }
+    for(unsigned int i = 0; i < numFiles; i++){
+        std::string name;
+        if(!BinaryIO::readString(in, name, bytesLeft)){
+            return false;
+        }
+        addFileName(name);
+    }
+
+    unsigned int numPairs;
+    if(!BinaryIO::readValue(in, numPairs)){
+        return false;
+    }
+    for(unsigned int i = 0; i < numPairs; i++){
+        int file1;
+        int file2;
+        unsigned int numBlocks;
+        if(!BinaryIO::readValue(in, file1) || !BinaryIO::readValue(in, file2) || !BinaryIO::readValue(in, numBlocks)){
+            return false;
+        }
+        for(unsigned int j = 0; j < numBlocks; j++){
+            DuplicateBlock block;
+            if(!BinaryIO::readValue(in, block.line1) || !BinaryIO::readValue(in, block.line2) || !BinaryIO::readValue(in, block.count)){
+                return false;
+            }
+            addBlock(file1, file2, block);
+        }
+    }
+
+    return true;
+}
+
+bool Baseline::save(const std::string& fileName) const {
+    const std::string tmpName = fileName + ".tmp";
+    {
+        std::ofstream out(tmpName.c_str(), std::ios::out|std::ios::binary);
+        if(!out.is_open()){
+            return false;
+        }
+
+        out.write(MAGIC, sizeof(MAGIC));
+        BinaryIO::writeValue<unsigned int>(out, BASELINE_VERSION);
+        BinaryIO::writeString(out, m_settings);
+        BinaryIO::writeValue(out, m_stopLinesHigh);
+        BinaryIO::writeValue(out, m_stopLinesLow);
+        m_files.write(out);
+
+        BinaryIO::writeValue<unsigned int>(out, (unsigned int)m_fileNames.size());
+        for(const auto& name : m_fileNames){
+            BinaryIO::writeString(out, name);
+        }
+
+        BinaryIO::writeValue<unsigned int>(out, (unsigned int)m_blocks.size());
+        for(const auto& it : m_blocks){
+            BinaryIO::writeValue(out, it.first.first);
+            BinaryIO::writeValue(out, it.first.second);
+            BinaryIO::writeValue<unsigned int>(out, (unsigned int)it.second.size());
+            for(const auto& block : it.second){
+                BinaryIO::writeValue(out, block.line1);
+                BinaryIO::writeValue(out, block.line2);
+                BinaryIO::writeValue(out, block.count);
+            }
+        }
+
+        if(!out){
+            return false;
+        }
+    }
+
+    std::remove(fileName.c_str());
+    return std::rename(tmpName.c_str(), fileName.c_str()) == 0;
+}
+
+void Baseline::setStopLines(unsigned long long high, unsigned long long low){
+    m_stopLinesHigh = high;
+    m_stopLinesLow = low;
+}
+
+bool Baseline::hasStopLines(unsigned long long high, unsigned long long low) const {
+    return m_stopLinesHigh == high && m_stopLinesLow == low;
+}
+
+const HashCache& Baseline::getFiles() const {
+    return m_files;
+}
+
+HashCache& Baseline::getFiles(){
+    return m_files;
+}
+
+int Baseline::getFileIndex(const std::string& fileName) const {
+    auto it = m_fileIndex.find(fileName);
+    return (it == m_fileIndex.end()) ? -1 : it->second;
+}
+
+void Baseline::addFileName(const std::string& fileName){
+    // The first position of a file listed twice is kept
+    m_fileIndex.insert(std::make_pair(fileName, (int)m_fileNames.size()));
+    m_fileNames.push_back(fileName);
+}
+
+const std::vector<DuplicateBlock>& Baseline::getBlocks(int file1, int file2) const {
+    static const std::vector<DuplicateBlock> none;
+
+    auto it = m_blocks.find(std::make_pair(file1, file2));
+    return (it == m_blocks.end()) ? none : it->second;
+}
+
+void Baseline::addBlock(int file1, int file2, const DuplicateBlock& block){
+    m_blocks[std::make_pair(file1, file2)].push_back(block);
+}
@@ -0,0 +1,88 @@
+/** \class Baseline
+ * The state of a previous run that an incremental run builds on.
+ *
+ * A baseline holds the line hashes of all files of a run, the order the
+ * files were compared in, and the blocks found for every pair of files.
+ * An incremental run takes the blocks of pairs whose files are both
+ * unchanged from the baseline and only compares the pairs with a changed
+ * file again.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _BASELINE_H_
+#define _BASELINE_H_
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "DuplicateBlock.h"
+#include "HashCache.h"
+
+const unsigned int BASELINE_VERSION = 2;
+
+class Baseline {
+protected:
+    std::string m_settings;
+    // Digest of the stop lines the blocks were found with, 0 without any
+    unsigned long long m_stopLinesHigh = 0;
+    unsigned long long m_stopLinesLow = 0;
+    HashCache m_files;
+    std::vector<std::string> m_fileNames;
+    std::unordered_map<std::string, int> m_fileIndex;
+    std::map<std::pair<int, int>, std::vector<DuplicateBlock>> m_blocks;
+
+public:
+    /**
+     * @param settings the settings that change the blocks found
+     * @param cacheSettings the settings that change the line hashes
+     */
+    Baseline(const std::string& settings, const std::string& cacheSettings);
+
+    bool load(const std::string& fileName);
+    bool save(const std::string& fileName) const;
+
+    /**
+     * @brief Set the digest of the stop lines of the run
+     *
+     * Stop lines depend on all files, so when they change the blocks of
+     * unchanged pairs may change too.
+     */
+    void setStopLines(unsigned long long high, unsigned long long low);
+    bool hasStopLines(unsigned long long high, unsigned long long low) const;
+
+    /**
+     * @brief Get the line hashes of the files
+     */
+    const HashCache& getFiles() const;
+    HashCache& getFiles();
+
+    /**
+     * @brief Get the position of a file in the compared files, or -1
+     */
+    int getFileIndex(const std::string& fileName) const;
+    void addFileName(const std::string& fileName);
+
+    /**
+     * @brief Get the blocks found between two files, given by their position
+     */
+    const std::vector<DuplicateBlock>& getBlocks(int file1, int file2) const;
+    void addBlock(int file1, int file2, const DuplicateBlock& block);
+};
+
+#endif
@@ -0,0 +1,125 @@
+
+#include "BinaryGenerator.h"
+#include "BinaryIO.h"
+#include "SourceFile.h"
+#include <cstring>
+#include <iostream>
+
+BinaryGenerator::BinaryGenerator( std::ostream & outfile, bool withText ) :
+    outfile_( outfile ),
+    withText_( withText ),
+    numRecords_( 0 ),
+    numBytes_( 0 )
+{
+}
+void BinaryGenerator::writeHeader( unsigned int m_minBlockSize,
+				 unsigned int m_minChars,
+				 bool m_ignorePrepStuff,
+				 bool m_ignoreSameFilename,
+                                 const std::string & version )
+{
+    const unsigned char flags[2] = { m_ignorePrepStuff, m_ignoreSameFilename };
+    outfile_.write( BinaryReport::MAGIC, sizeof( BinaryReport::MAGIC ) );
+    BinaryIO::writeValue( outfile_, BINARYREPORT_VERSION );
+    BinaryIO::writeValue( outfile_, m_minBlockSize );
+    BinaryIO::writeValue( outfile_, m_minChars );
+    outfile_.write( (const char*)flags, sizeof( flags ) );
+    BinaryIO::writeString( outfile_, version );
+
+    numBytes_ = sizeof( BinaryReport::MAGIC ) + 3 * sizeof( unsigned int ) + sizeof( flags ) + sizeof( unsigned int ) + version.size( );
+}
+void BinaryGenerator::reportSeq(int line1,
+			      int line2,
+			      int count,
+			      const SourceFile& pSource1,
+			      const SourceFile& pSource2 )
+{
+    writeRecord( BinaryReport::Record{ getFileIndex( pSource1 ), pSource1.getLine(line1).getLineNumber(),
+                                       getFileIndex( pSource2 ), pSource2.getLine(line2).getLineNumber(),
+                                       count, addLines( pSource1, line1, count ) } );
+}
+
+void BinaryGenerator::reportClass(int count,
+                                  const std::vector<std::pair<const SourceFile*, int>> & blocks )
+{
+    const SourceFile& pSource1 = *blocks[0].first;
+    writeRecord( BinaryReport::Record{ getFileIndex( pSource1 ), pSource1.getLine(blocks[0].second).getLineNumber(),
+                                       -(int)blocks.size(), 0,
+                                       count, addLines( pSource1, blocks[0].second, count ) } );
+    for(size_t k = 1; k < blocks.size(); k++){
+        writeRecord( BinaryReport::Record{ getFileIndex( *blocks[k].first ), blocks[k].first->getLine(blocks[k].second).getLineNumber(),
+                                           0, 0, 0, -1 } );
+    }
+}
+
+int BinaryGenerator::getFileIndex( const SourceFile& pSource )
+{
+    auto it = fileIndices_.find( &pSource );
+    if( it != fileIndices_.end( ) ) {
+        return it->second;
+    }
+
+    const int index = (int)files_.size( );
+    fileIndices_[&pSource] = index;
+    files_.push_back( pSource.getFilename( ) );
+    return index;
+}
+
+int BinaryGenerator::addLines( const SourceFile& pSource, int line, int count )
+{
+    if( !withText_ ) {
+        return -1;
+    }
+
+    // Each text is kept once, the blocks refer to it
+    const int first = (int)lines_.size( );
+    for(int j = 0; j < count; j++)
+    {
+        auto it = textIndices_.emplace( pSource.getLineText( j+line ), (unsigned int)texts_.size( ) );
+        if( it.second ) {
+            texts_.push_back( &it.first->first );
+        }
+        lines_.push_back( it.first->second );
+    }
+    return first;
+}
+
+void BinaryGenerator::writeRecord( const BinaryReport::Record & record )
+{
+    BinaryIO::writeValue( outfile_, record );
+    numRecords_++;
+    numBytes_ += sizeof( record );
+}
+
+void BinaryGenerator::writeSummary( int num_files,
+			          int blocks_total,
+			          int locks_total,
+			          int num_duplicate_lines,
+			          double duration)
+{
+    BinaryReport::Trailer trailer;
+    trailer.numRecords = numRecords_;
+    trailer.tablesOffset = numBytes_;
+    memcpy( trailer.magic, BinaryReport::MAGIC, sizeof( trailer.magic ) );
+
+    BinaryIO::writeValue<unsigned int>( outfile_, (unsigned int)files_.size( ) );
+    for(const auto& file : files_){
+        BinaryIO::writeString( outfile_, file );
+    }
+    BinaryIO::writeValue<unsigned int>( outfile_, (unsigned int)lines_.size( ) );
+    outfile_.write( (const char*)lines_.data( ), lines_.size( ) * sizeof( unsigned int ) );
+    BinaryIO::writeValue<unsigned int>( outfile_, (unsigned int)texts_.size( ) );
+    for(const auto* text : texts_){
+        BinaryIO::writeString( outfile_, *text );
+    }
+
+    BinaryIO::writeValue( outfile_, num_files );
+    BinaryIO::writeValue( outfile_, blocks_total );
+    BinaryIO::writeValue( outfile_, locks_total );
+    BinaryIO::writeValue( outfile_, num_duplicate_lines );
+    BinaryIO::writeValue( outfile_, duration );
+    BinaryIO::writeValue( outfile_, trailer );
+
+    // The report is complete, only now it has to reach the file
+    outfile_.flush();
+}
@@ -0,0 +1,59 @@
+
+#if!defined __BINARY_GENERATOR__
+#define __BINARY_GENERATOR__
+
+#include "IOutGenerator.h"
+#include "BinaryReport.h"
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Writes the report in the format of BinaryReport, which duplo-report
+// turns into text, XML or JSON
+class BinaryGenerator : public IOutGenerator
+{
+    public:
+
+    // withText: keep the texts of the lines, otherwise only their places
+    BinaryGenerator( std::ostream & outfile, bool withText );
+    virtual void writeHeader( unsigned int m_minBlockSize,
+                      unsigned int m_minChars,
+		      bool m_ignorePrepStuff,
+                      bool m_ignoreSameFilename,
+                      const std::string & version) override;
+    virtual void reportSeq(int line1,
+		   int line2,
+		   int count,
+		   const SourceFile& pSource1,
+		   const SourceFile& pSource2 ) override;
+
+    virtual void reportClass(int count,
+                   const std::vector<std::pair<const SourceFile*, int>> & blocks ) override;
+
+    virtual void writeSummary( int num_files,
+                       int blocks_total,
+                       int locks_total,
+                       int num_duplicate_lines,
+                       double duration
+                       ) override;
+    private:
+    int getFileIndex( const SourceFile& pSource );
+    int addLines( const SourceFile& pSource, int line, int count );
+    void writeRecord( const BinaryReport::Record & record );
+
+    std::ostream & outfile_;
+    bool withText_;
+    unsigned long long numRecords_;
+    unsigned long long numBytes_;
+
+    std::unordered_map<const SourceFile*, int> fileIndices_;
+    std::vector<std::string> files_;
+    std::unordered_map<std::string, unsigned int> textIndices_;
+    std::vector<const std::string*> texts_;
+    std::vector<unsigned int> lines_;
+};
+
+
+
+#endif
@@ -0,0 +1,78 @@
+/** \class BinaryIO
+ * BinaryIO, reads and writes plain values in the binary files of duplo
+ *
+ * Values are stored in the byte order of the machine, the files are
+ * meant to be read back on the machine that wrote them.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _BINARYIO_H_
+#define _BINARYIO_H_
+
+#include <iostream>
+#include <string>
+
+class BinaryIO{
+
+public:
+    template <typename T>
+    static void writeValue(std::ostream& out, T value){
+        out.write((const char*)&value, sizeof(value));
+    }
+
+    static void writeString(std::ostream& out, const std::string& str){
+        writeValue<unsigned int>(out, (unsigned int)str.size());
+        out.write(str.data(), str.size());
+    }
+
+    template <typename T>
+    static bool readValue(std::istream& in, T& value){
+        return (bool)in.read((char*)&value, sizeof(value));
+    }
+
+    /**
+     * @brief Bytes from the read position to the end of the stream, 0 if
+     * the stream can't tell
+     *
+     * Counts and sizes read from a file are checked against it before
+     * anything is allocated for them, so a truncated or corrupt file
+     * fails to read instead of asking for gigabytes.
+     */
+    static unsigned long long getBytesLeft(std::istream& in){
+        const std::streampos pos = in.tellg();
+        if(pos < 0 || !in.seekg(0, std::ios::end)){
+            in.clear();
+            return 0;
+        }
+        const std::streampos end = in.tellg();
+        in.seekg(pos);
+        return (end > pos) ? (unsigned long long)(end - pos) : 0;
+    }
+
+    /**
+     * @brief Read a string of at most maxSize bytes
+     */
+    static bool readString(std::istream& in, std::string& str, unsigned long long maxSize){
+        unsigned int size;
+        if(!readValue(in, size) || size > maxSize){
+            return false;
+        }
+        str.resize(size);
+        return size == 0 || (bool)in.read(&str[0], size);
+    }
+};
+
+#endif
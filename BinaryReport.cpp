@@ -0,0 +1,141 @@
+/**
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "BinaryReport.h"
+
+#include "BinaryIO.h"
+
+#include <cstring>
+#include <fstream>
+
+const char BinaryReport::MAGIC[8] = { 'D', 'U', 'P', 'L', 'O', 'R', 'P', 0 };
+
+BinaryReport::BinaryReport() :
+    minBlockSize(0),
+    minChars(0),
+    ignorePrepStuff(false),
+    ignoreSameFilename(false),
+    numFiles(0),
+    blocksTotal(0),
+    linesTotal(0),
+    duplicateLines(0),
+    duration(0)
+{
+}
+
+namespace {
+    // Each string takes at least the bytes of its size
+    bool readStrings(std::istream& in, std::vector<std::string>& strings, unsigned long long bytesLeft){
+        unsigned int size;
+        if(!BinaryIO::readValue(in, size) || (unsigned long long)size * sizeof(unsigned int) > bytesLeft){
+            return false;
+        }
+        strings.resize(size);
+        for(auto& str : strings){
+            if(!BinaryIO::readString(in, str, bytesLeft)){
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+bool BinaryReport::load(const std::string& fileName){
+    std::ifstream in(fileName.c_str(), std::ios::in|std::ios::binary);
+    if(!in.is_open()){
+        return false;
+    }
+
+    const unsigned long long bytesLeft = BinaryIO::getBytesLeft(in);
+
+    char magic[sizeof(MAGIC)];
+    unsigned int fileVersion;
+    unsigned char flags[2];
+    if(!in.read(magic, sizeof(magic)) || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+       !BinaryIO::readValue(in, fileVersion) || fileVersion != BINARYREPORT_VERSION ||
+       !BinaryIO::readValue(in, minBlockSize) || !BinaryIO::readValue(in, minChars) ||
+       !in.read((char*)flags, sizeof(flags)) || !BinaryIO::readString(in, version, bytesLeft)){
+        return false;
+    }
+    ignorePrepStuff = flags[0] != 0;
+    ignoreSameFilename = flags[1] != 0;
+    const std::streamoff recordsOffset = in.tellg();
+
+    Trailer trailer;
+    if(!in.seekg(-(std::streamoff)sizeof(trailer), std::ios::end)){
+        return false;
+    }
+    const std::streamoff trailerOffset = in.tellg();
+    if(!BinaryIO::readValue(in, trailer) || memcmp(trailer.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+       trailer.tablesOffset > (unsigned long long)trailerOffset ||
+       trailer.tablesOffset != recordsOffset + trailer.numRecords * sizeof(Record)){
+        return false;
+    }
+
+    records.resize(trailer.numRecords);
+    if(!in.seekg(recordsOffset) ||
+       (!records.empty() && !in.read((char*)records.data(), records.size() * sizeof(Record)))){
+        return false;
+    }
+
+    unsigned int numLines;
+    if(!readStrings(in, files, bytesLeft) || !BinaryIO::readValue(in, numLines) ||
+       (unsigned long long)numLines * sizeof(unsigned int) > bytesLeft){
+        return false;
+    }
+    lines.resize(numLines);
+    if((numLines > 0 && !in.read((char*)lines.data(), lines.size() * sizeof(unsigned int))) ||
+       !readStrings(in, texts, bytesLeft) ||
+       !BinaryIO::readValue(in, numFiles) || !BinaryIO::readValue(in, blocksTotal) ||
+       !BinaryIO::readValue(in, linesTotal) || !BinaryIO::readValue(in, duplicateLines) ||
+       !BinaryIO::readValue(in, duration)){
+        return false;
+    }
+
+    // Check the indices once, so the records can be used as they are
+    for(size_t i = 0; i < records.size(); i++){
+        const Record& record = records[i];
+        if(record.file1 < 0 || record.file1 >= (int)files.size() || record.file2 >= (int)files.size() ||
+           record.count < 0 ||
+           (record.text >= 0 && (size_t)record.text + record.count > lines.size())){
+            return false;
+        }
+        if(record.file2 < 0){
+            const int numPlaces = -record.file2;
+            if(numPlaces < 2 || i + numPlaces > records.size()){
+                return false;
+            }
+            for(int k = 1; k < numPlaces; k++){
+                if(records[i + k].file1 < 0 || records[i + k].file1 >= (int)files.size()){
+                    return false;
+                }
+            }
+            i += numPlaces - 1;
+        }
+    }
+    for(unsigned int text : lines){
+        if(text >= texts.size()){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+const std::string& BinaryReport::getLineText(const Record& record, int j) const {
+    static const std::string empty;
+    return (record.text < 0) ? empty : texts[lines[record.text + j]];
+}
@@ -0,0 +1,92 @@
+/** \class BinaryReport
+ * The binary report written by BinaryGenerator, and its reader.
+ *
+ * The report starts with a header holding the settings of the run. Then
+ * come the records, one fixed size Record per block. The tables after
+ * the records hold the file names and the texts of the lines the records
+ * refer to by index, each text stored once. The report ends with the
+ * summary and a trailer locating the tables, so the report can be
+ * written in one pass while the blocks are found.
+ *
+ * A record of a block found in two files names both places. A block found
+ * in more places is a record with file2 set to minus the number of
+ * places, followed by a record for each further place holding only
+ * file1 and line1.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _BINARYREPORT_H_
+#define _BINARYREPORT_H_
+
+#include <string>
+#include <vector>
+
+const unsigned int BINARYREPORT_VERSION = 1;
+
+class BinaryReport {
+public:
+    static const char MAGIC[8];
+
+    struct Record {
+        int file1;
+        int line1;      // line number in the file, as in the text report
+        int file2;      // minus the number of places for a block in more files
+        int line2;
+        int count;
+        int text;       // index of the first line of the block in the line table, -1 without text
+    };
+
+    struct Trailer {
+        unsigned long long numRecords;
+        unsigned long long tablesOffset;
+        char magic[8];
+    };
+
+    // Settings of the run
+    unsigned int minBlockSize;
+    unsigned int minChars;
+    bool ignorePrepStuff;
+    bool ignoreSameFilename;
+    std::string version;
+
+    std::vector<Record> records;
+    std::vector<std::string> files;
+
+    // Text index of every line of the blocks, in the order of the records
+    std::vector<unsigned int> lines;
+    std::vector<std::string> texts;
+
+    // Summary of the run
+    int numFiles;
+    int blocksTotal;
+    int linesTotal;
+    int duplicateLines;
+    double duration;
+
+    BinaryReport();
+
+    /**
+     * @return false if the file is missing, truncated or no binary report
+     */
+    bool load(const std::string& fileName);
+
+    /**
+     * @brief Text of line j of the block of a record, empty without text
+     */
+    const std::string& getLineText(const Record& record, int j) const;
+};
+
+#endif
@@ -0,0 +1,117 @@
+/**
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "CloneClasses.h"
+
+#include <algorithm>
+
+namespace {
+    int find(std::vector<int>& parents, int node){
+        while(parents[node] != node){
+            // Path halving, every other node skips to its grandparent
+            parents[node] = parents[parents[node]];
+            node = parents[node];
+        }
+        return node;
+    }
+}
+
+bool CloneClasses::Fragment::operator<(const Fragment& other) const
+{
+    if(file != other.file){
+        return file < other.file;
+    }
+    if(line != other.line){
+        return line < other.line;
+    }
+    return count < other.count;
+}
+
+bool CloneClasses::Fragment::operator==(const Fragment& other) const
+{
+    return file == other.file && line == other.line && count == other.count;
+}
+
+void CloneClasses::add(int file1, int file2, const DuplicateBlock& block)
+{
+    m_links.push_back(Fragment{ file1, block.line1, block.count });
+    m_links.push_back(Fragment{ file2, block.line2, block.count });
+    m_numBlocks++;
+}
+
+void CloneClasses::build()
+{
+    // Number the distinct fragments
+    std::vector<Fragment> fragments(m_links);
+    std::sort(fragments.begin(), fragments.end());
+    fragments.erase(std::unique(fragments.begin(), fragments.end()), fragments.end());
+
+    auto getId = [ & ] (const Fragment& fragment) -> int
+        {
+            return (int)(std::lower_bound(fragments.begin(), fragments.end(), fragment) - fragments.begin());
+        };
+
+    std::vector<int> parents(fragments.size());
+    std::vector<int> sizes(fragments.size(), 1);
+    for(size_t k = 0; k < parents.size(); k++){
+        parents[k] = (int)k;
+    }
+    for(size_t k = 0; k < m_links.size(); k += 2){
+        int a = find(parents, getId(m_links[k]));
+        int b = find(parents, getId(m_links[k + 1]));
+        if(a == b){
+            continue;
+        }
+        if(sizes[a] < sizes[b]){
+            std::swap(a, b);
+        }
+        parents[b] = a;
+        sizes[a] += sizes[b];
+    }
+    std::vector<Fragment>().swap(m_links);
+
+    // The fragments are sorted, so each class gets its places in order
+    // and the class of a root is created at its first place
+    m_classes.clear();
+    std::vector<int> classOfRoot(fragments.size(), -1);
+    for(size_t k = 0; k < fragments.size(); k++){
+        const int root = find(parents, (int)k);
+        if(classOfRoot[root] < 0){
+            classOfRoot[root] = (int)m_classes.size();
+            m_classes.push_back(Class{ fragments[k].count, std::vector<std::pair<int, int>>() });
+            m_classes.back().places.reserve(sizes[root]);
+        }
+        m_classes[classOfRoot[root]].places.emplace_back(fragments[k].file, fragments[k].line);
+    }
+
+    std::stable_sort(m_classes.begin(), m_classes.end(), [ ] (const Class& a, const Class& b) -> bool
+        {
+            if(a.places[0] != b.places[0]){
+                return a.places[0] < b.places[0];
+            }
+            return a.count > b.count;
+        });
+}
+
+const std::vector<CloneClasses::Class>& CloneClasses::getClasses() const
+{
+    return m_classes;
+}
+
+long long CloneClasses::getNumOfBlocks() const
+{
+    return m_numBlocks;
+}
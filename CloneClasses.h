@@ -0,0 +1,76 @@
+/** \class CloneClasses
+ * Merges the blocks found between file pairs into clone classes, so a
+ * block pasted into K files is reported once with its K places instead
+ * of as K*(K-1)/2 pairs.
+ *
+ * Each side of a block is a fragment: a file, the line it starts at and
+ * its length. Blocks join their two fragments in a union-find, fragments
+ * that are equal are the same. The connected fragments form a class, all
+ * of the same length, and as equal lines have equal hashes each of them
+ * holds the same lines as the others.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _CLONECLASSES_H_
+#define _CLONECLASSES_H_
+
+#include <utility>
+#include <vector>
+
+#include "DuplicateBlock.h"
+
+class CloneClasses {
+public:
+    struct Fragment {
+        int file;
+        int line;
+        int count;
+
+        bool operator<(const Fragment& other) const;
+        bool operator==(const Fragment& other) const;
+    };
+
+    struct Class {
+        int count;
+        // The places of the class as (file, line), sorted
+        std::vector<std::pair<int, int>> places;
+    };
+
+protected:
+    // Both fragments of each block, one after the other
+    std::vector<Fragment> m_links;
+    std::vector<Class> m_classes;
+    long long m_numBlocks = 0;
+
+public:
+    /**
+     * @brief Add a block found between file1 and file2
+     */
+    void add(int file1, int file2, const DuplicateBlock& block);
+
+    /**
+     * @brief Merge the blocks added so far into classes
+     *
+     * The classes are ordered by their first place, classes starting at
+     * the same place longest first.
+     */
+    void build();
+
+    const std::vector<Class>& getClasses() const;
+    long long getNumOfBlocks() const;
+};
+
+#endif
@@ -0,0 +1,172 @@
+/**
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "CommentStripper.h"
+
+#include <cstring>
+
+const CommentStripper::Syntax* CommentStripper::GetSyntax(FileType::FILETYPE fileType){
+    struct Syntaxes {
+        Syntax c;
+        Syntax vb;
+
+        Syntaxes(){
+            // C, C++, Java, C# and QML: // and /* */ comments, "" and '' literals
+            memset(c.classes, CHAR_PLAIN, sizeof(c.classes));
+            c.classes['\n'] = CHAR_NEWLINE;
+            c.classes['/'] = CHAR_SLASH;
+            c.classes['*'] = CHAR_STAR;
+            c.classes['"'] = CHAR_QUOTE;
+            c.classes['\''] = CHAR_QUOTE;
+            c.classes['\\'] = CHAR_BACKSLASH;
+            c.escapes = true;
+            c.digitSeparators = true;
+
+            // VB: ' comments, "" literals with doubled quotes inside
+            memset(vb.classes, CHAR_PLAIN, sizeof(vb.classes));
+            vb.classes['\n'] = CHAR_NEWLINE;
+            vb.classes['"'] = CHAR_QUOTE;
+            vb.classes['\''] = CHAR_LINE_COMMENT;
+            vb.escapes = false;
+            vb.digitSeparators = false;
+        }
+    };
+
+    static const Syntaxes syntaxes;
+
+    switch(fileType){
+        case FileType::FILETYPE_C   :
+        case FileType::FILETYPE_CPP :
+        case FileType::FILETYPE_CXX :
+        case FileType::FILETYPE_H   :
+        case FileType::FILETYPE_HPP :
+        case FileType::FILETYPE_JAVA:
+        case FileType::FILETYPE_CS  :
+        case FileType::FILETYPE_QML :
+            return &syntaxes.c;
+        case FileType::FILETYPE_VB  :
+            return &syntaxes.vb;
+        default:
+            return nullptr;
+    }
+}
+
+void CommentStripper::strip(const char* begin, const char* end, FileType::FILETYPE fileType, std::string& code){
+    code.clear();
+
+    const Syntax* syntax = GetSyntax(fileType);
+    if(!syntax){
+        code.assign(begin, end);
+        return;
+    }
+    const unsigned char* classes = syntax->classes;
+
+    // Code is copied in runs, from run up to p
+    const char* run = begin;
+    const char* p = begin;
+    STATE state = STATE_CODE;
+    char quote = 0;
+    while(p != end){
+        switch(state){
+            case STATE_CODE:
+                while(p != end && classes[(unsigned char)*p] <= CHAR_NEWLINE){
+                    p++;
+                }
+                if(p == end){
+                    break;
+                }
+                switch(classes[(unsigned char)*p]){
+                    case CHAR_SLASH:
+                        if(p + 1 != end && (p[1] == '/' || p[1] == '*')){
+                            code.append(run, p);
+                            state = (p[1] == '/') ? STATE_LINE_COMMENT : STATE_BLOCK_COMMENT;
+                            p += 2;
+                        } else {
+                            p++;
+                        }
+                        break;
+                    case CHAR_LINE_COMMENT:
+                        code.append(run, p);
+                        state = STATE_LINE_COMMENT;
+                        p++;
+                        break;
+                    case CHAR_QUOTE:
+                        if(syntax->digitSeparators && *p == '\'' && p != begin && p[-1] >= '0' && p[-1] <= '9'){
+                            p++;
+                            break;
+                        }
+                        quote = *p++;
+                        state = STATE_LITERAL;
+                        break;
+                    default:
+                        p++;
+                        break;
+                }
+                break;
+
+            case STATE_LINE_COMMENT:
+                p = (const char*)memchr(p, '\n', end - p);
+                if(!p){
+                    p = end;
+                    run = end;
+                    break;
+                }
+                // The newline is code again
+                run = p;
+                state = STATE_CODE;
+                break;
+
+            case STATE_BLOCK_COMMENT:
+                while(p != end && classes[(unsigned char)*p] != CHAR_STAR && classes[(unsigned char)*p] != CHAR_NEWLINE){
+                    p++;
+                }
+                if(p == end){
+                    break;
+                }
+                if(*p == '\n'){
+                    code.push_back('\n');
+                    p++;
+                } else if(p + 1 != end && p[1] == '/'){
+                    p += 2;
+                    run = p;
+                    state = STATE_CODE;
+                } else {
+                    p++;
+                }
+                break;
+
+            case STATE_LITERAL:
+                if(*p == '\n'){
+                    // Unterminated, the newline is code again
+                    state = STATE_CODE;
+                } else if(syntax->escapes && *p == '\\'){
+                    p += (p + 1 != end && p[1] != '\n') ? 2 : 1;
+                } else if(*p++ == quote){
+                    if(!syntax->escapes && p != end && *p == quote){
+                        // A doubled quote inside the literal
+                        p++;
+                    } else {
+                        state = STATE_CODE;
+                    }
+                }
+                break;
+        }
+    }
+
+    if(state != STATE_BLOCK_COMMENT){
+        code.append(run, end);
+    }
+}
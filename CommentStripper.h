@@ -0,0 +1,71 @@
+/** \class CommentStripper
+ * Removes the comments of a source file in one pass over its buffer.
+ *
+ * A state machine walks the bytes once, the class of every byte is looked
+ * up in a table of the language of the file. String and character
+ * literals are kept as they are, comment markers inside them are not
+ * comments. Block comments do not nest. The newlines inside block comments
+ * are kept, so every line of the result has the number of the line it
+ * came from. Literals end at the end of their line at the latest, so a
+ * stray quote can not hide the rest of the file.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _COMMENTSTRIPPER_H_
+#define _COMMENTSTRIPPER_H_
+
+#include <string>
+
+#include "FileType.h"
+
+class CommentStripper {
+public:
+    /**
+     * @brief Write the file [begin, end) without its comments to code
+     *
+     * code is cleared first, its capacity is reused. Files of unknown type
+     * are copied as they are.
+     */
+    static void strip(const char* begin, const char* end, FileType::FILETYPE fileType, std::string& code);
+
+private:
+    enum CHARCLASS {
+        CHAR_PLAIN,
+        CHAR_NEWLINE,
+        CHAR_SLASH,         // may start a comment
+        CHAR_STAR,          // may end a block comment
+        CHAR_QUOTE,         // starts a literal
+        CHAR_BACKSLASH,     // escapes the next byte in a literal
+        CHAR_LINE_COMMENT   // starts a line comment on its own
+    };
+
+    enum STATE {
+        STATE_CODE,
+        STATE_LINE_COMMENT,
+        STATE_BLOCK_COMMENT,
+        STATE_LITERAL
+    };
+
+    struct Syntax {
+        unsigned char classes[256];
+        bool escapes;           // backslash escapes, otherwise doubled quotes
+        bool digitSeparators;
+    };
+
+    static const Syntax* GetSyntax(FileType::FILETYPE fileType);
+};
+
+#endif
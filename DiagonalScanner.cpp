@@ -0,0 +1,187 @@
+/**
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "DiagonalScanner.h"
+
+#include "HashMatch.h"
+
+#include <algorithm>
+
+unsigned long long DiagonalScanner::makeKey(unsigned int y, unsigned int x, unsigned int m)
+{
+    // Diagonals starting at (y, 0) come first, those starting at (0, x) follow
+    unsigned long long diagonal = (y >= x) ? (y - x) : (m - 1 + x - y);
+
+    return (diagonal << 32) | x;
+}
+
+int DiagonalScanner::scan(const unsigned long long* begin, const unsigned long long* end,
+                          unsigned int m, unsigned int minBlockSize, bool sameFile,
+                          std::vector<DuplicateBlock>& blocks)
+{
+    int found = 0;
+
+    const unsigned long long* it = begin;
+    while(it != end){
+
+        const unsigned int diagonal = (unsigned int)(*it >> 32);
+        const unsigned int start = (unsigned int)*it;
+
+        // Grow the run along its diagonal
+        unsigned int seqLen = 1;
+        ++it;
+        while(it != end && *it == ((unsigned long long)diagonal << 32 | (start + seqLen))){
+            seqLen++;
+            ++it;
+        }
+
+        if(sameFile && (diagonal == 0 || diagonal >= m)){
+            // The main diagonal and the part above it mirror the part below it
+            continue;
+        }
+
+        if(seqLen >= minBlockSize){
+            int line1 = (diagonal < m) ? (int)(start + diagonal) : (int)start - (int)(diagonal - m + 1);
+
+            blocks.push_back(DuplicateBlock{ line1, (int)start, (int)seqLen });
+            found++;
+        }
+    }
+
+    return found;
+}
+
+int DiagonalScanner::scanSeeds(const unsigned long long* begin, const unsigned long long* end,
+                               const long long* highs1, const long long* lows1,
+                               const long long* highs2, const long long* lows2,
+                               unsigned int m, unsigned int n, unsigned int minBlockSize, bool sameFile,
+                               std::vector<DuplicateBlock>& blocks)
+{
+    int found = 0;
+
+    // End of the last run grown, later keys inside it belong to it
+    unsigned int lastDiagonal = 0;
+    unsigned int lastEnd = 0;
+    bool grown = false;
+
+    for(const unsigned long long* it = begin; it != end; ++it){
+
+        const unsigned int diagonal = (unsigned int)(*it >> 32);
+        const unsigned int start = (unsigned int)*it;
+
+        if(grown && diagonal == lastDiagonal && start < lastEnd){
+            continue;
+        }
+
+        const unsigned int y = (diagonal < m) ? start + diagonal : start - (diagonal - m + 1);
+        unsigned int seqLen = 1;
+        while(y + seqLen < m && start + seqLen < n &&
+              highs1[y + seqLen] == highs2[start + seqLen] && lows1[y + seqLen] == lows2[start + seqLen]){
+            seqLen++;
+        }
+        lastDiagonal = diagonal;
+        lastEnd = start + seqLen;
+        grown = true;
+
+        if(sameFile && (diagonal == 0 || diagonal >= m)){
+            // The main diagonal and the part above it mirror the part below it
+            continue;
+        }
+
+        if(seqLen >= minBlockSize){
+            blocks.push_back(DuplicateBlock{ (int)y, (int)start, (int)seqLen });
+            found++;
+        }
+    }
+
+    return found;
+}
+
+int DiagonalScanner::scanRolling(const long long* highs1, const long long* lows1,
+                                 const long long* highs2, const long long* lows2,
+                                 unsigned int m, unsigned int n, unsigned int minBlockSize, bool sameFile,
+                                 std::vector<int>& runs, std::vector<unsigned long long>& matches,
+                                 std::vector<DuplicateBlock>& blocks)
+{
+    const size_t first = blocks.size();
+
+    // Column x of a row is kept at x+1, so that column -1 is always 0 and
+    // column n never matches and ends the runs of the last column
+    runs.assign(2 * ((size_t)n + 2), 0);
+    int* prev = runs.data();
+    int* cur = prev + n + 2;
+    const int minLength = (int)minBlockSize;
+    matches.resize(((size_t)n + 63) / 64);
+
+    // Row m matches nothing and ends the runs of the last row
+    for(unsigned int y = 0; y <= m; y++){
+
+        if(y < m){
+            // Most words of a row match nothing and only clear their runs
+            HashMatch::matchRow(highs1[y], lows1[y], highs2, lows2, n, matches.data());
+            for(unsigned int x0 = 0; x0 < n; x0 += 64){
+                const unsigned long long bits = matches[x0 / 64];
+                const unsigned int x1 = std::min(n, x0 + 64);
+                if(bits == 0){
+                    std::fill(cur + x0 + 1, cur + x1 + 1, 0);
+                    continue;
+                }
+                for(unsigned int x = x0; x < x1; x++){
+                    const int match = (int)((bits >> (x - x0)) & 1);
+                    cur[x + 1] = (prev[x] + 1) & -match;
+                }
+            }
+        } else {
+            std::fill(cur + 1, cur + n + 1, 0);
+        }
+
+        // Runs through y-1 and x-1 that do not continue are rare, look
+        // for them one chunk at a time
+        const unsigned int CHUNK = 256;
+        for(unsigned int x0 = 0; x0 <= n; x0 += CHUNK){
+            const unsigned int x1 = std::min(n + 1, x0 + CHUNK);
+            int ended = 0;
+            for(unsigned int x = x0; x < x1; x++){
+                ended |= (prev[x] >= minLength) & (cur[x + 1] == 0);
+            }
+            if(!ended){
+                continue;
+            }
+
+            for(unsigned int x = x0; x < x1; x++){
+                if(prev[x] >= minLength && cur[x + 1] == 0){
+                    const int line1 = (int)y - prev[x];
+                    const int line2 = (int)x - prev[x];
+
+                    // The main diagonal and the part above it mirror the part below it
+                    if(!(sameFile && line1 <= line2)){
+                        blocks.push_back(DuplicateBlock{ line1, line2, prev[x] });
+                    }
+                }
+            }
+        }
+
+        std::swap(prev, cur);
+    }
+
+    // Rows end runs of all diagonals mixed, order them as scan does
+    std::sort(blocks.begin() + first, blocks.end(), [ m ] ( const DuplicateBlock & a, const DuplicateBlock & b ) -> bool
+        {
+            return makeKey(a.line1, a.line2, m) < makeKey(b.line1, b.line2, m);
+        });
+
+    return (int)(blocks.size() - first);
+}
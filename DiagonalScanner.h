@@ -0,0 +1,90 @@
+/** \class DiagonalScanner
+ * Extracts duplicate blocks from the matching lines of two files.
+ *
+ * A match (y, x) means line y of the first file equals line x of the
+ * second file. Matches are encoded as keys that sort in the same order
+ * the dense matrix scan visits them: first the diagonals starting in the
+ * first column (y - x >= 0) from top to bottom, then the diagonals
+ * starting in the first row from left to right, each walked from its
+ * beginning to its end. Scanning sorted keys therefore yields the blocks
+ * in exactly the order the matrix engine reports them.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _DIAGONALSCANNER_H_
+#define _DIAGONALSCANNER_H_
+
+#include <vector>
+
+#include "DuplicateBlock.h"
+
+class DiagonalScanner {
+public:
+    /**
+     * @brief Encode a match between line y of the first file and line x of the second
+     *
+     * @param m number of lines of code of the first file
+     */
+    static unsigned long long makeKey(unsigned int y, unsigned int x, unsigned int m);
+
+    /**
+     * @brief Collect all runs of consecutive matches of at least minBlockSize lines
+     *
+     * @param begin, end sorted match keys
+     * @param m number of lines of code of the first file
+     * @param sameFile true if both files are the same, only the part below the
+     *        main diagonal is scanned then
+     * @return number of blocks appended
+     */
+    static int scan(const unsigned long long* begin, const unsigned long long* end,
+                    unsigned int m, unsigned int minBlockSize, bool sameFile,
+                    std::vector<DuplicateBlock>& blocks);
+
+    /**
+     * @brief Collect the runs that start at one of the given matches
+     *
+     * Unlike scan, the keys need not contain every match of a run: each
+     * run is grown from its first key by comparing the line hashes. The
+     * part of a run before its first key is left out.
+     *
+     * @param highs1, lows1, highs2, lows2 line hashes of both files
+     * @param n number of lines of code of the second file
+     */
+    static int scanSeeds(const unsigned long long* begin, const unsigned long long* end,
+                         const long long* highs1, const long long* lows1,
+                         const long long* highs2, const long long* lows2,
+                         unsigned int m, unsigned int n, unsigned int minBlockSize, bool sameFile,
+                         std::vector<DuplicateBlock>& blocks);
+
+    /**
+     * @brief Collect all runs of at least minBlockSize lines in one pass
+     * over the line hashes, without a matrix or match keys
+     *
+     * Only the run lengths of the previous and the current row are kept,
+     * the run through line y and x continuing the one through y-1 and x-1.
+     * The blocks come out in the same order as from scan.
+     *
+     * @param runs, matches buffers for the run lengths and the matches of
+     *        one row, resized as needed
+     */
+    static int scanRolling(const long long* highs1, const long long* lows1,
+                           const long long* highs2, const long long* lows2,
+                           unsigned int m, unsigned int n, unsigned int minBlockSize, bool sameFile,
+                           std::vector<int>& runs, std::vector<unsigned long long>& matches,
+                           std::vector<DuplicateBlock>& blocks);
+};
+
+#endif
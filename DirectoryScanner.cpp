@@ -0,0 +1,228 @@
+/**
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "DirectoryScanner.h"
+
+#include "FileType.h"
+#include "StringUtil.h"
+#include "ThreadPool.h"
+
+#include <iostream>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+namespace {
+    // A directory entry, as far as the scan needs it
+    struct Entry {
+        std::string name;
+        bool isDirectory;
+        bool isFile;
+    };
+
+    // Reads the entries of a directory, without . and ..
+    bool readDirectory(const std::string& path, std::vector<Entry>& entries){
+        entries.clear();
+#if defined(_WIN32)
+        WIN32_FIND_DATAA data;
+        HANDLE find = FindFirstFileA((path + "\\*").c_str(), &data);
+        if(find == INVALID_HANDLE_VALUE){
+            return false;
+        }
+        do {
+            const std::string name(data.cFileName);
+            if(name == "." || name == ".." || (data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT)){
+                continue;
+            }
+            const bool isDirectory = (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+            entries.push_back(Entry{ name, isDirectory, !isDirectory });
+        } while(FindNextFileA(find, &data));
+        FindClose(find);
+#else
+        DIR* dir = opendir(path.c_str());
+        if(!dir){
+            return false;
+        }
+        while(struct dirent* entry = readdir(dir)){
+            const std::string name(entry->d_name);
+            if(name == "." || name == ".."){
+                continue;
+            }
+
+            bool isDirectory = false;
+            bool isFile = false;
+#if defined(DT_DIR)
+            if(entry->d_type == DT_DIR){
+                isDirectory = true;
+            } else if(entry->d_type == DT_REG){
+                isFile = true;
+            } else if(entry->d_type == DT_LNK || entry->d_type == DT_UNKNOWN)
+#endif
+            {
+                // Links are followed to files only, not to directories
+                struct stat st;
+                if(stat((path + "/" + name).c_str(), &st) == 0){
+                    isFile = S_ISREG(st.st_mode);
+#if defined(DT_DIR)
+                    isDirectory = S_ISDIR(st.st_mode) && entry->d_type == DT_UNKNOWN;
+#else
+                    isDirectory = S_ISDIR(st.st_mode);
+#endif
+                }
+            }
+            entries.push_back(Entry{ name, isDirectory, isFile });
+        }
+        closedir(dir);
+#endif
+        return true;
+    }
+}
+
+DirectoryScanner::DirectoryScanner(const std::string& root, const std::string& includes, const std::string& excludes) :
+    m_root(root)
+{
+    // A trailing separator would be doubled in the paths
+    while(m_root.size() > 1 && (m_root.back() == '/' || m_root.back() == '\\')){
+        m_root.pop_back();
+    }
+    if(!includes.empty()){
+        StringUtil::split(includes, ",", m_includes, true);
+    }
+    if(!excludes.empty()){
+        StringUtil::split(excludes, ",", m_excludes, true);
+    }
+}
+
+void DirectoryScanner::scan(ThreadPool* pool, const Callback& found) const {
+    if(pool){
+        pool->submit([ this, pool, &found ] ( int ) { scanDirectory(m_root, "", pool, found); });
+    } else {
+        scanDirectory(m_root, "", nullptr, found);
+    }
+}
+
+void DirectoryScanner::scanDirectory(const std::string& path, const std::string& relativePath, ThreadPool* pool, const Callback& found) const {
+    std::vector<Entry> entries;
+    if(!readDirectory(path, entries)){
+        std::cout << "Error: Can't read directory: " << path << "\n";
+        return;
+    }
+
+    for(const auto& entry : entries){
+        const std::string entryPath = path + "/" + entry.name;
+        const std::string entryRelativePath = relativePath.empty() ? entry.name : relativePath + "/" + entry.name;
+        if(entry.isDirectory){
+            if(pool){
+                pool->submit([ this, entryPath, entryRelativePath, pool, &found ] ( int )
+                    {
+                        scanDirectory(entryPath, entryRelativePath, pool, found);
+                    });
+            } else {
+                scanDirectory(entryPath, entryRelativePath, nullptr, found);
+            }
+        } else if(entry.isFile && isWanted(entryRelativePath, entry.name)){
+            found(entryPath);
+        }
+    }
+}
+
+bool DirectoryScanner::isWanted(const std::string& relativePath, const std::string& name) const {
+    auto matches = [ & ] ( const std::string& pattern ) -> bool
+        {
+            const std::string& subject = (pattern.find('/') != std::string::npos) ? relativePath : name;
+            return matchGlob(pattern.c_str(), subject.c_str());
+        };
+
+    // Without patterns only files of a known type are taken, a pattern
+    // takes whatever it matches, like a file list does
+    bool included = m_includes.empty() && FileType::GetFileType(name) != FileType::FILETYPE_UNKNOWN;
+    for(const auto& pattern : m_includes){
+        if(matches(pattern)){
+            included = true;
+            break;
+        }
+    }
+    if(!included){
+        return false;
+    }
+    for(const auto& pattern : m_excludes){
+        if(matches(pattern)){
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DirectoryScanner::matchGlob(const char* pattern, const char* name){
+    // Backtracks to the last * only, which is enough for globs
+    const char* star = nullptr;
+    const char* starName = nullptr;
+    while(*name){
+        bool matched = false;
+        const char* next = pattern + 1;
+        if(*pattern == '*'){
+            star = pattern++;
+            starName = name;
+            continue;
+        } else if(*pattern == '?'){
+            matched = true;
+        } else if(*pattern == '['){
+            const char* p = pattern + 1;
+            const bool negate = (*p == '!' || *p == '^');
+            if(negate){
+                p++;
+            }
+            bool inSet = false;
+            for(bool first = true; *p && (first || *p != ']'); first = false){
+                if(p[1] == '-' && p[2] && p[2] != ']'){
+                    inSet |= (*name >= p[0] && *name <= p[2]);
+                    p += 3;
+                } else {
+                    inSet |= (*name == *p);
+                    p++;
+                }
+            }
+            if(*p == ']'){
+                matched = (inSet != negate);
+                next = p + 1;
+            } else {
+                // No closing ], the [ is an ordinary character
+                matched = (*name == '[');
+            }
+        } else {
+            matched = (*pattern == *name);
+        }
+
+        if(matched && *pattern){
+            pattern = next;
+            name++;
+        } else if(star){
+            pattern = star + 1;
+            name = ++starName;
+        } else {
+            return false;
+        }
+    }
+
+    while(*pattern == '*'){
+        pattern++;
+    }
+    return *pattern == 0;
+}
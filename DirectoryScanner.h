@@ -0,0 +1,77 @@
+/** \class DirectoryScanner
+ * Finds the source files below a directory, instead of a file list.
+ *
+ * Files are taken if they match one of the include patterns, or without
+ * include patterns if duplo knows their FileType, and none of the exclude
+ * patterns.
+ * Patterns are globs with *, ? and [...], a pattern with a '/' is matched
+ * against the path below the root, others against the file name only.
+ * Symbolic links to directories are not followed.
+ *
+ * With a ThreadPool each directory is read by a task of its own, and the
+ * files are handed to the caller as soon as they are found, so they can
+ * be loaded while the scan goes on.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _DIRECTORYSCANNER_H_
+#define _DIRECTORYSCANNER_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+class ThreadPool;
+
+class DirectoryScanner {
+public:
+    /**
+     * Gets the path of a file found. With a ThreadPool it is called on
+     * the threads of the pool, several at a time.
+     */
+    typedef std::function<void(const std::string& fileName)> Callback;
+
+protected:
+    std::string m_root;
+    std::vector<std::string> m_includes;
+    std::vector<std::string> m_excludes;
+
+    bool isWanted(const std::string& relativePath, const std::string& name) const;
+    void scanDirectory(const std::string& path, const std::string& relativePath, ThreadPool* pool, const Callback& found) const;
+
+public:
+    /**
+     * @param includes, excludes comma separated glob patterns
+     */
+    DirectoryScanner(const std::string& root, const std::string& includes, const std::string& excludes);
+
+    /**
+     * @brief Call found for each file wanted below the root
+     *
+     * Without a pool the directories are read one after the other on the
+     * calling thread. With one the scan runs on the pool, wait on it for
+     * the end of the scan, the scanner and found have to live until then.
+     * Directories that can't be read are reported and skipped.
+     */
+    void scan(ThreadPool* pool, const Callback& found) const;
+
+    /**
+     * @brief Whether name matches the glob pattern
+     */
+    static bool matchGlob(const char* pattern, const char* name);
+};
+
+#endif
@@ -0,0 +1,28 @@
+/** \class DuplicateBlock
+ * A run of matching lines between two source files
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _DUPLICATEBLOCK_H_
+#define _DUPLICATEBLOCK_H_
+
+struct DuplicateBlock {
+    int line1;  // index of the first line of code in the first file
+    int line2;  // index of the first line of code in the second file
+    int count;  // number of lines of code
+};
+
+#endif
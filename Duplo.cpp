@@ -1,384 +1,1495 @@
-/**
- * This program is free software; you can redistribute it and/or modify
- * it under the terms of the GNU General Public License as published by
- * the Free Software Foundation; either version 2 of the License, or
- * (at your option) any later version.
- * 
- * This program is distributed in the hope that it will be useful,
- * but WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
- * GNU General Public License for more details.
- * 
- * You should have received a copy of the GNU General Public License
- * along with this program; if not, write to the Free Software
- * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
- */
-
-#include "Duplo.h"
-
-#include <fstream>
-#include <time.h>
-
-#include <algorithm>
-#include <cassert>
-
-#include "SourceFile.h"
-
-#include "StringUtil.h"
-#include "TextFile.h"
-#include "ArgumentParser.h"
-#include "TextGenerator.h"
-#include "XMLGenerator.h"
-
-using std::cout;
-using std::endl;
-
-Duplo::Duplo(
-    const std::string& listFileName, 
-    unsigned int minBlockSize, 
-    unsigned int blockPercentThreshold,
-    unsigned int minChars, 
-    bool ignorePrepStuff, bool ignoreSameFilename, bool Xml) :
-    m_listFileName(listFileName),
-    m_minBlockSize(minBlockSize),
-    m_blockPercentThreshold(blockPercentThreshold),
-    m_minChars(minChars),
-    m_ignorePrepStuff(ignorePrepStuff),
-    m_ignoreSameFilename(ignoreSameFilename),
-    m_maxLinesPerFile(0),
-    m_DuplicateLines(0),
-    m_Xml(Xml),
-    m_pMatrix(),
-    _report_generator( )
-{
-}
-
-Duplo::~Duplo(){
-}
-
-void Duplo::reportSeq(int line1, 
-                      int line2, 
-                      int count, 
-                      const SourceFile& pSource1, 
-                      const SourceFile& pSource2, 
-                      std::ostream& outFile){
-
-    _report_generator->reportSeq( line1, line2, count, pSource1, pSource2 );
-    m_DuplicateLines += count;
-}
-
-int Duplo::process(const SourceFile& pSource1, const SourceFile& pSource2, std::ostream& outFile) 
-{
-
-    const unsigned int m = pSource1.getNumOfLinesOfCode();
-    const unsigned int n = pSource2.getNumOfLinesOfCode();
-
-
-    //const unsigned char NONE = 0;
-    //const unsigned char MATCH = 1;
-
-    long long index = m * n;
-    assert( ( index ) < matrix_size );
-
-    // Reset matrix data
-    std::fill( m_pMatrix.begin( ), m_pMatrix.begin( ) + ( m * n ) , false );
-
-    // Compute matrix
-    for(unsigned int y=0; y<m; y++){
-        const auto & pSLine = pSource1.getLine(y);
-        for(unsigned int x=0; x<n; x++){
-
-            if( pSLine.equals( pSource2.getLine( x ) ) ) {
-                m_pMatrix.at( x+n*y ) = true;
-            }
-        }
-    }
-
-    // support reporting filtering by both:
-    // - "lines of code duplicated", &
-    // - "percentage of file duplicated"
-    const unsigned int lMinBlockSize = std::max(
-        1u, std::min(
-            m_minBlockSize, 
-            (std::max(n,m)*100)/m_blockPercentThreshold
-        )
-    );
-    
-    int blocks=0;
-
-    // Scan vertical part
-    for(unsigned int y=0; y<m; y++){
-
-        unsigned int seqLen=0;
-        int maxX = std::min(n, m-y);
-        for(int x=0; x<maxX; x++){
-
-            if(m_pMatrix.at( x+n*(y+x) ) == true ){
-
-
-                seqLen++;
-            } else {
-
-                if(seqLen >= lMinBlockSize){
-
-                    int line1 = y+x-seqLen;
-
-                    int line2 = x-seqLen;
-
-                    if (!((line1 == line2) && (pSource1.getFilename( ) == pSource2.getFilename( ) ) ) ) {
-
-                        reportSeq(line1, line2, seqLen, pSource1, pSource2, outFile);
-                        blocks++;
-                    }
-                }
-                seqLen=0;
-            }
-        }
-
-        if(seqLen >= lMinBlockSize){
-            int line1 = m-seqLen;
-            int line2 = n-seqLen;
-            if (!((line1 == line2) && (pSource1.getFilename( ) == pSource2.getFilename( ) ) ) ) {
-                reportSeq(line1, line2, seqLen, pSource1, pSource2, outFile);
-                blocks++;
-            }
-        }
-    }
-
-    if (pSource1.getFilename( ) != pSource2.getFilename( ) )
-    {
-        // Scan horizontal part
-        for(unsigned int x=1; x<n; x++){
-            unsigned int seqLen=0;
-            int maxY = std::min(m, n-x);
-            for(int y=0; y<maxY; y++){
-                if(m_pMatrix.at( x+y+n*y ) == true ){
-                    seqLen++;
-                } else {
-                    if(seqLen >= lMinBlockSize){
-                        reportSeq(y-seqLen, x+y-seqLen, seqLen, pSource1, pSource2, outFile);
-                        blocks++;
-                    }
-                    seqLen=0;
-                }
-            }
-
-            if(seqLen >= lMinBlockSize){
-                reportSeq(m-seqLen, n-seqLen, seqLen, pSource1, pSource2, outFile);
-                blocks++;
-            }
-        }
-    }
-
-    return blocks;
-}
-
-const std::string Duplo::getFilenamePart(const std::string& fullpath) const {
-    std::string path = StringUtil::substitute('\\', '/', fullpath);
-
-    std::string filename = path;
-
-    std::string::size_type idx = path.rfind('/');
-    if(idx != std::string::npos){
-        filename = path.substr(idx+1, path.size()-idx-1);
-    }
-
-    return filename;
-}
-
-bool Duplo::isSameFilename(const std::string& filename1, const std::string& filename2) const {
-    return (getFilenamePart(filename1) == getFilenamePart(filename2));
-}
-
-void Duplo::run(std::string outputFileName) {
-
-    std::ofstream outfile(outputFileName.c_str(), std::ios::out|std::ios::binary);
-    
-    if(!outfile.is_open()) {
-        std::cout << "Error: Can't open file: " << outputFileName << std::endl;
-        return;
-    }
-
-    if( m_Xml )
-    {
-        _report_generator = std::make_unique<XMLGenerator>( outfile );
-    }
-    else
-    {
-        _report_generator = std::make_unique<TextGenerator>( outfile );   
-    }
-
-    _report_generator->writeHeader( m_minBlockSize, m_minChars, m_ignorePrepStuff, m_ignoreSameFilename, VERSION );
-
-
-    clock_t start, finish;
-    double  duration;
-
-    start = clock();
-
-    std::cout << "Loading and hashing files ... ";
-    std::cout.flush();
-
-    
-    TextFile listOfFiles(m_listFileName.c_str());
-    std::vector<std::string> lines;
-    listOfFiles.readLines(lines, true);
-    
-    std::vector<SourceFile> sourceFiles;
-    sourceFiles.reserve( lines.size( ) );
-    
-    int files = 0;
-    int locsTotal = 0;
-
-
-    //Set values for processing of files.
-    SourceFile::setMinChars( m_minChars );
-    SourceFile::setIgnorePreprocessor( m_ignorePrepStuff );
-
-    // Create vector with all source files
-    for( auto & line: lines ) {
-
-        if(line.size() > 5){
-
-            SourceFile sf( line );
-            int numLines = sf.getNumOfLinesOfFile();
-
-            if(numLines > 0 ) {
-
-                files++;
-                sourceFiles.push_back( std::move( sf ) );
-                locsTotal+=numLines;
-
-            }
-            
-        }
-    }
-
-    auto it= std::max_element( sourceFiles.begin( ), sourceFiles.end( ), [ ] ( SourceFile & sf1, SourceFile & sf2 ) -> bool
-            {
-              return sf1.getNumOfLinesOfFile( ) < sf2.getNumOfLinesOfFile( );
-            });
-
-    m_maxLinesPerFile = it->getNumOfLinesOfFile( );
-
-    std::cout << "done.\n\n";
-
-    // Generate matrix large enough for all files
-    matrix_size = (long)m_maxLinesPerFile * m_maxLinesPerFile;
-    m_pMatrix = std::vector<bool>( matrix_size, false );
-    std::cout << "Max size of long = " << std::numeric_limits<long>::max( ) << endl;
-    std::cout << "Try to reserve a vector with " << matrix_size << " elements" << endl;
-    std::cout << "Maximum size of a 'vector' is " << m_pMatrix.max_size() << "\n";
-
-
-    int blocksTotal = 0;
-
-    try
-    {
-
-    // Compare each file with each other
-    for(int i=0;i<(int)sourceFiles.size();i++){
-
-        std::cout << sourceFiles[i].getFilename();
-        int blocks = 0;
-        
-        blocks+=process( sourceFiles[i], sourceFiles[i], outfile );
-        for(int j=i+1;j<(int)sourceFiles.size();j++){
-
-            if ( ( m_ignoreSameFilename && isSameFilename( sourceFiles[ i ].getFilename(), sourceFiles[j].getFilename() ) ) == false ) {
-
-                blocks+=process( sourceFiles[ i ], sourceFiles[ j ], outfile );
-            }
-        }
-
-        if(blocks > 0){
-            std::cout << " found: " << blocks << " block(s)" << std::endl;
-        } else {
-            std::cout << " nothing found." << std::endl;
-        }
-
-        blocksTotal+=blocks;
-    }
-    }
-    catch( std::out_of_range & exc )
-    {
-        cout << "Out range error " << exc.what( ) << endl << endl;
-    }
-
-
-
-    finish = clock();
-    duration = (double)(finish - start) / CLOCKS_PER_SEC;
-    std::cout << "Time: "<< duration << " seconds" << std::endl;
-
-    _report_generator->writeSummary( files, blocksTotal, locsTotal, m_DuplicateLines, duration );
-}
-
-int Clamp (int upper, int lower, int value)
-{
-    return std::max( lower, std::min( upper, value ) );
-}
-
-/**
- * Main routine
- *
- * @param argc  number of arguments
- * @param argv  arguments
- */
-const int MIN_BLOCK_SIZE = 4;
-const int MIN_CHARS = 3;
-
-void DisplayHelp( );
-
-int main(int argc, const char* argv[]){
-    ArgumentParser ap(argc, argv);
-
-
-    if(!ap.is("--help") && argc > 2){
-        Duplo duplo(
-            argv[argc-2], 
-            ap.getInt("-ml", MIN_BLOCK_SIZE), 
-            Clamp( 100, 0, ap.getInt("-pt", 100) ),
-            ap.getInt("-mc", MIN_CHARS), 
-            ap.is("-ip"), ap.is("-d"), ap.is("-xml")
-        );
-        duplo.run(argv[argc-1]);
-    } else {
-        DisplayHelp( );
-    }
-
-    return 0;
-}
-
-void DisplayHelp( )
-{
-    std::cout << "\nNAME\n";
-    std::cout << "       Duplo " << VERSION << " - duplicate source code block finder\n\n";
-
-    std::cout << "\nSYNOPSIS\n";
-    std::cout << "       duplo [OPTIONS] [INTPUT_FILELIST] [OUTPUT_FILE]\n";
-
-    std::cout << "\nDESCRIPTION\n";
-    std::cout << "       Duplo is a tool to find duplicated code blocks in large\n";
-    std::cout << "       C/C++/Java/C#/VB.Net software systems.\n\n";
-
-    std::cout << "       -ml              minimal block size in lines (default is " << MIN_BLOCK_SIZE << ")\n";
-    std::cout << "       -pt              percentage of lines of duplication threshold to override -ml\n";
-    std::cout << "                        (default is 100%)\n";
-    std::cout << "                        useful for identifying whole file class duplication\n";
-    std::cout << "       -mc              minimal characters in line (default is " << MIN_CHARS << ")\n";
-    std::cout << "                        lines with less characters are ignored\n";
-    std::cout << "       -ip              ignore preprocessor directives\n";
-    std::cout << "       -d               ignore file pairs with same name\n";
-    std::cout << "       -xml             output file in XML\n";
-    std::cout << "       INTPUT_FILELIST  input filelist\n";
-    std::cout << "       OUTPUT_FILE      output file\n";
-
-    std::cout << "\nVERSION\n";
-    std::cout << "       " << VERSION << "\n";
-
-    std::cout << "\nAUTHORS\n";
-    std::cout << "       Christian M. Ammann (cammann@giants.ch)\n";    
-    std::cout << "       Trevor D'Arcy-Evans (tdarcyevans@hotmail.com)\n\n";    
-}
-
+/**
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "Duplo.h"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <time.h>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <mutex>
+
+#include "SourceFile.h"
+#include "DiagonalScanner.h"
+#include "HashIndex.h"
+#include "ThreadPool.h"
+#include "DirectoryScanner.h"
+#include "HashCache.h"
+#include "Baseline.h"
+#include "HashMatch.h"
+#include "SuffixArray.h"
+#include "FingerprintIndex.h"
+
+#include "StringUtil.h"
+#include "TextFile.h"
+#include "ReportSink.h"
+#include "Metrics.h"
+#include "CloneClasses.h"
+
+using std::cout;
+using std::endl;
+
+Duplo::Duplo(
+    const std::string& listFileName, 
+    unsigned int minBlockSize, 
+    unsigned int blockPercentThreshold,
+    unsigned int minChars, 
+    bool ignorePrepStuff, bool ignoreSameFilename, bool Xml) :
+    m_listFileName(listFileName),
+    m_minBlockSize(minBlockSize),
+    m_blockPercentThreshold(blockPercentThreshold),
+    m_minChars(minChars),
+    m_ignorePrepStuff(ignorePrepStuff),
+    m_ignoreSameFilename(ignoreSameFilename),
+    m_maxLinesPerFile(0),
+    m_DuplicateLines(0),
+    m_format(Xml ? GeneratorFactory::FORMAT_XML : GeneratorFactory::FORMAT_TEXT),
+    m_engine(ENGINE_SPARSE),
+    m_numThreads(1),
+    m_hashFunction(HashUtil::HASH_MURMUR3),
+    m_cacheFileName(),
+    m_numCachedFiles(0),
+    m_numBaselineFiles(0),
+    _report_generator( ),
+    m_stopFrequency(0),
+    m_numTopStopLines(TOP_STOP_LINES),
+    m_maxMemory(MAX_MEMORY),
+    m_asyncReport(false),
+    m_reportText(true),
+    m_normalizeTokens(false),
+    m_statsFileName(),
+    m_cloneClasses(false),
+    m_numComparedPairs(0),
+    m_numPrunedPairs(0),
+    m_numLineMatches(0),
+    m_numStopMatches(0)
+{
+}
+
+Duplo::~Duplo(){
+}
+
+void Duplo::setEngine(ENGINE engine){
+    m_engine = engine;
+}
+
+void Duplo::setNumOfThreads(int numThreads){
+    m_numThreads = std::max(1, numThreads);
+}
+
+void Duplo::setHashFunction(HashUtil::HASH hash){
+    m_hashFunction = hash;
+}
+
+void Duplo::setCacheFile(const std::string& fileName){
+    m_cacheFileName = fileName;
+}
+
+void Duplo::setBaseline(const std::string& fileName, const std::string& changedFileName){
+    m_baselineFileName = fileName;
+    m_changedFileName = changedFileName;
+}
+
+void Duplo::setSaveBaseline(const std::string& fileName){
+    m_saveBaselineFileName = fileName;
+}
+
+void Duplo::setStopLines(int frequency, int numOfTop){
+    m_stopFrequency = std::max(0, frequency);
+    m_numTopStopLines = std::max(0, numOfTop);
+}
+
+void Duplo::setMaxMemory(int megaBytes){
+    m_maxMemory = std::max(1, megaBytes);
+}
+
+void Duplo::setScanRoot(const std::string& root, const std::string& includes, const std::string& excludes){
+    m_scanRoot = root;
+    m_includes = includes;
+    m_excludes = excludes;
+}
+
+void Duplo::setAsyncReport(bool async){
+    m_asyncReport = async;
+}
+
+void Duplo::setReportFormat(GeneratorFactory::FORMAT format, bool withText){
+    m_format = format;
+    m_reportText = withText;
+}
+
+void Duplo::setNormalizeTokens(bool normalize){
+    m_normalizeTokens = normalize;
+}
+
+void Duplo::setStatsFile(const std::string& fileName){
+    m_statsFileName = fileName;
+}
+
+void Duplo::setCloneClasses(bool classes){
+    m_cloneClasses = classes;
+}
+
+bool Duplo::GetEngine(const std::string& name, ENGINE& engine){
+    if(name == "sparse"){
+        engine = ENGINE_SPARSE;
+    } else if(name == "matrix"){
+        engine = ENGINE_MATRIX;
+    } else if(name == "index"){
+        engine = ENGINE_INDEX;
+    } else if(name == "suffix"){
+        engine = ENGINE_SUFFIX;
+    } else if(name == "winnow"){
+        engine = ENGINE_WINNOW;
+    } else if(name == "rolling"){
+        engine = ENGINE_ROLLING;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void Duplo::reportSeq(int line1, 
+                      int line2, 
+                      int count, 
+                      const SourceFile& pSource1, 
+                      const SourceFile& pSource2){
+
+    _report_generator->reportSeq( line1, line2, count, pSource1, pSource2 );
+    m_DuplicateLines += count;
+}
+
+int Duplo::reportRow(const RowChunk& chunk,
+                     const std::vector<SourceFile>& sourceFiles){
+
+    Metrics::Timer timer( Metrics::PHASE_REPORT );
+    for(const auto& block : chunk.blocks){
+        if( m_nextBaseline ) {
+            m_nextBaseline->addBlock(chunk.file, block.first, block.second);
+        }
+        if( m_classes ) {
+            // Reported as part of its class once all pairs are compared
+            m_classes->add(chunk.file, block.first, block.second);
+            continue;
+        }
+        reportSeq(block.second.line1, block.second.line2, block.second.count,
+                  sourceFiles[chunk.file], sourceFiles[block.first]);
+    }
+    return (int)chunk.blocks.size();
+}
+
+unsigned int Duplo::getMinBlockSize(unsigned int m, unsigned int n) const {
+    // support reporting filtering by both:
+    // - "lines of code duplicated", &
+    // - "percentage of file duplicated"
+    return std::max(
+        1u, std::min(
+            m_minBlockSize, 
+            (std::max(n,m)*100)/m_blockPercentThreshold
+        )
+    );
+}
+
+unsigned int Duplo::getSmallestMinBlockSize(const std::vector<SourceFile>& sourceFiles) const {
+    // No file pair has a smaller minimal block size than its files alone
+    unsigned int minBlockSize = m_minBlockSize;
+    for( auto & sf : sourceFiles ) {
+        const unsigned int n = sf.getNumOfLinesOfCode( );
+        minBlockSize = std::min( minBlockSize, getMinBlockSize( n, n ) );
+    }
+    return minBlockSize;
+}
+
+std::string Duplo::getHashSettings() const {
+    std::ostringstream settings;
+    settings << "mc=" << m_minChars << " ip=" << m_ignorePrepStuff << " hash=" << m_hashFunction;
+    if( m_normalizeTokens ) {
+        settings << " tn";
+    }
+    return settings.str();
+}
+
+std::string Duplo::getBlockSettings() const {
+    std::ostringstream settings;
+    settings << "ml=" << m_minBlockSize << " pt=" << m_blockPercentThreshold << " d=" << m_ignoreSameFilename;
+    if( m_engine == ENGINE_SUFFIX ) {
+        // Reports repeats instead of file pairs
+        settings << " suffix";
+    }
+    if( m_stopFrequency > 0 ) {
+        settings << " sf=" << m_stopFrequency;
+    }
+    return settings.str();
+}
+
+bool Duplo::isInBaseline(int file1, int file2) const {
+    if( !m_baseline ) {
+        return false;
+    }
+
+    // The baseline only has the blocks of the pair in the same order
+    const int baseline1 = m_baselineIndex[file1];
+    const int baseline2 = m_baselineIndex[file2];
+    if( file1 == file2 ) {
+        return baseline1 >= 0;
+    }
+    return baseline1 >= 0 && baseline2 >= 0 && baseline1 < baseline2;
+}
+
+void Duplo::trimStopLines(const SourceFile& pSource1, const SourceFile& pSource2, std::vector<DuplicateBlock>& blocks) const
+{
+    const char* stopLines = pSource1.getStopLines( );
+    if( !stopLines ) {
+        return;
+    }
+
+    // Blocks start at their first line that is no stop line
+    const unsigned int minBlockSize = getMinBlockSize( pSource1.getNumOfLinesOfCode( ), pSource2.getNumOfLinesOfCode( ) );
+    size_t kept = 0;
+    for( auto block : blocks ) {
+        while( block.count > 0 && stopLines[block.line1] ) {
+            block.line1++;
+            block.line2++;
+            block.count--;
+        }
+        if( (unsigned int)block.count >= minBlockSize ) {
+            blocks[kept++] = block;
+        }
+    }
+    blocks.resize( kept );
+}
+
+int Duplo::process(const SourceFile& pSource1, const SourceFile& pSource2, Scratch& scratch) const
+{
+    const unsigned int m = pSource1.getNumOfLinesOfCode();
+    const unsigned int n = pSource2.getNumOfLinesOfCode();
+    const bool self = ( &pSource1 == &pSource2 );
+
+    const std::vector<int>& order1 = pSource1.getLinesByHash();
+    const std::vector<int>& order2 = pSource2.getLinesByHash();
+    const long long* highs1 = pSource1.getHashHighs();
+    const long long* lows1 = pSource1.getHashLows();
+    const long long* highs2 = pSource2.getHashHighs();
+    const long long* lows2 = pSource2.getHashLows();
+    const char* stopLines = pSource1.getStopLines();
+
+    // Join the lines of both files on their hash, only the matching pairs
+    // are kept. Within the file itself only the part below the main
+    // diagonal is needed. Stop lines can not start a block, so their
+    // matches are left out and runs are grown over them instead.
+    long long numMatches = 0;
+    long long numStopMatches = 0;
+    std::vector<unsigned long long>& keys = scratch.keys;
+    keys.clear();
+    unsigned int a = 0;
+    unsigned int b = 0;
+    while(a < m && b < n){
+        const long long high1 = highs1[order1[a]];
+        const long long low1 = lows1[order1[a]];
+        const long long high2 = highs2[order2[b]];
+        const long long low2 = lows2[order2[b]];
+
+        if(high1 < high2 || (high1 == high2 && low1 < low2)){
+            a++;
+        } else if(high2 < high1 || (high2 == high1 && low2 < low1)){
+            b++;
+        } else {
+            unsigned int aEnd = a + 1;
+            while(aEnd < m && highs1[order1[aEnd]] == high1 && lows1[order1[aEnd]] == low1){
+                aEnd++;
+            }
+            unsigned int bEnd = b + 1;
+            while(bEnd < n && highs2[order2[bEnd]] == high2 && lows2[order2[bEnd]] == low2){
+                bEnd++;
+            }
+
+            const long long numGroupMatches = self ? (long long)(aEnd - a) * (aEnd - a + 1) / 2 : (long long)(aEnd - a) * (bEnd - b);
+            numMatches += numGroupMatches;
+            if(stopLines && stopLines[order1[a]]){
+                numStopMatches += numGroupMatches;
+                a = aEnd;
+                b = bEnd;
+                continue;
+            }
+
+            for(unsigned int i = a; i < aEnd; i++){
+                for(unsigned int j = b; j < bEnd; j++){
+                    if(self && order2[j] > order1[i]){
+                        break;
+                    }
+                    keys.push_back(DiagonalScanner::makeKey(order1[i], order2[j], m));
+                }
+            }
+
+            a = aEnd;
+            b = bEnd;
+        }
+    }
+
+    std::sort(keys.begin(), keys.end());
+
+    scratch.blocks.clear();
+    if(stopLines){
+        m_numLineMatches += numMatches;
+        m_numStopMatches += numStopMatches;
+        return DiagonalScanner::scanSeeds(keys.data(), keys.data() + keys.size(), highs1, lows1, highs2, lows2,
+                                          m, n, getMinBlockSize(m, n), pSource1.getFilename() == pSource2.getFilename(), scratch.blocks);
+    }
+    return DiagonalScanner::scan(keys.data(), keys.data() + keys.size(), m, getMinBlockSize(m, n),
+                                 pSource1.getFilename() == pSource2.getFilename(), scratch.blocks);
+}
+
+int Duplo::processMatrix(const SourceFile& pSource1, const SourceFile& pSource2, Scratch& scratch) const
+{
+    std::vector<unsigned long long>& matrix = scratch.matrix;
+    scratch.blocks.clear();
+
+    const unsigned int m = pSource1.getNumOfLinesOfCode();
+    const unsigned int n = pSource2.getNumOfLinesOfCode();
+    const unsigned int words = ( n + 63 ) / 64;
+
+    long long index = (long long)m * words;
+    if( index > (long long)matrix.size( ) ) {
+
+        // The matrix of this pair does not fit in memory
+        return processTiled( pSource1, pSource2, scratch );
+    }
+
+    // Compute matrix, every row is written as a whole
+    const long long* highs1 = pSource1.getHashHighs();
+    const long long* lows1 = pSource1.getHashLows();
+    const long long* highs2 = pSource2.getHashHighs();
+    const long long* lows2 = pSource2.getHashLows();
+    for(unsigned int y=0; y<m; y++){
+        HashMatch::matchRow( highs1[y], lows1[y], highs2, lows2, n, &matrix[ (size_t)y*words ] );
+    }
+
+    auto isMatch = [ & ] ( unsigned int y, unsigned int x ) -> bool
+        {
+            return ( matrix[ (size_t)y*words + x/64 ] >> ( x%64 ) ) & 1;
+        };
+
+    const unsigned int lMinBlockSize = getMinBlockSize(m, n);
+
+    int blocks=0;
+
+    // Scan vertical part
+    for(unsigned int y=0; y<m; y++){
+
+        unsigned int seqLen=0;
+        int maxX = std::min(n, m-y);
+        for(int x=0; x<maxX; x++){
+
+            if( isMatch( y+x, x ) ){
+
+
+                seqLen++;
+            } else {
+
+                if(seqLen >= lMinBlockSize){
+
+                    int line1 = y+x-seqLen;
+
+                    int line2 = x-seqLen;
+
+                    if (!((line1 == line2) && (pSource1.getFilename( ) == pSource2.getFilename( ) ) ) ) {
+
+                        scratch.blocks.push_back(DuplicateBlock{ line1, line2, (int)seqLen });
+                        blocks++;
+                    }
+                }
+                seqLen=0;
+            }
+        }
+
+        if(seqLen >= lMinBlockSize){
+            int line1 = y+maxX-seqLen;
+            int line2 = maxX-seqLen;
+            if (!((line1 == line2) && (pSource1.getFilename( ) == pSource2.getFilename( ) ) ) ) {
+                scratch.blocks.push_back(DuplicateBlock{ line1, line2, (int)seqLen });
+                blocks++;
+            }
+        }
+    }
+
+    if (pSource1.getFilename( ) != pSource2.getFilename( ) )
+    {
+        // Scan horizontal part
+        for(unsigned int x=1; x<n; x++){
+            unsigned int seqLen=0;
+            int maxY = std::min(m, n-x);
+            for(int y=0; y<maxY; y++){
+                if( isMatch( y, x+y ) ){
+                    seqLen++;
+                } else {
+                    if(seqLen >= lMinBlockSize){
+                        scratch.blocks.push_back(DuplicateBlock{ y-(int)seqLen, (int)(x+y-seqLen), (int)seqLen });
+                        blocks++;
+                    }
+                    seqLen=0;
+                }
+            }
+
+            if(seqLen >= lMinBlockSize){
+                scratch.blocks.push_back(DuplicateBlock{ maxY-(int)seqLen, (int)(x+maxY-seqLen), (int)seqLen });
+                blocks++;
+            }
+        }
+    }
+
+    return blocks;
+}
+
+int Duplo::processTiled(const SourceFile& pSource1, const SourceFile& pSource2, Scratch& scratch) const
+{
+    std::vector<unsigned long long>& tile = scratch.matrix;
+    scratch.blocks.clear();
+
+    const unsigned int m = pSource1.getNumOfLinesOfCode();
+    const unsigned int n = pSource2.getNumOfLinesOfCode();
+    const unsigned int lMinBlockSize = getMinBlockSize(m, n);
+    const bool sameFile = ( pSource1.getFilename( ) == pSource2.getFilename( ) );
+
+    const long long* highs1 = pSource1.getHashHighs();
+    const long long* lows1 = pSource1.getHashLows();
+    const long long* highs2 = pSource2.getHashHighs();
+    const long long* lows2 = pSource2.getHashLows();
+
+    // The run ending at line y of the first and x of the second file is
+    // kept on diagonal y - x + n - 1. Tiles are visited row by row, so the
+    // run of a diagonal entering a tile was left there by an earlier tile.
+    std::vector<int>& runs = scratch.runs;
+    runs.assign( (size_t)m + n - 1, 0 );
+
+    auto addBlock = [ & ] ( int line1, int line2, int count )
+        {
+            // The main diagonal and the part above it mirror the part below it
+            if( !( sameFile && line1 <= line2 ) ) {
+                scratch.blocks.push_back(DuplicateBlock{ line1, line2, count });
+            }
+        };
+
+    const unsigned int words = MATRIX_TILE_SIZE / 64;
+    for(unsigned int y0=0; y0<m; y0+=MATRIX_TILE_SIZE){
+        const unsigned int y1 = std::min(m, y0 + MATRIX_TILE_SIZE);
+
+        for(unsigned int x0=0; x0<n; x0+=MATRIX_TILE_SIZE){
+            const unsigned int x1 = std::min(n, x0 + MATRIX_TILE_SIZE);
+
+            for(unsigned int y=y0; y<y1; y++){
+                HashMatch::matchRow( highs1[y], lows1[y], highs2 + x0, lows2 + x0, x1 - x0, &tile[ (size_t)(y-y0)*words ] );
+            }
+
+            for(unsigned int y=y0; y<y1; y++){
+                const unsigned long long* row = &tile[ (size_t)(y-y0)*words ];
+                int* run = &runs[ (size_t)y + n - 1 - x0 ];
+                for(unsigned int x=x0; x<x1; x++, run--){
+
+                    if( ( row[ (x-x0)/64 ] >> ( (x-x0)%64 ) ) & 1 ) {
+                        (*run)++;
+                        if( y == m-1 || x == n-1 ) {
+
+                            // The diagonal ends with the run
+                            if( (unsigned int)*run >= lMinBlockSize ) {
+                                addBlock( y+1-*run, x+1-*run, *run );
+                            }
+                            *run = 0;
+                        }
+                    } else if( *run > 0 ) {
+                        if( (unsigned int)*run >= lMinBlockSize ) {
+                            addBlock( y-*run, x-*run, *run );
+                        }
+                        *run = 0;
+                    }
+                }
+            }
+        }
+    }
+
+    // Report the blocks in the order the whole matrix is scanned in
+    std::sort( scratch.blocks.begin( ), scratch.blocks.end( ), [ m ] ( const DuplicateBlock & a, const DuplicateBlock & b ) -> bool
+        {
+            return DiagonalScanner::makeKey( a.line1, a.line2, m ) < DiagonalScanner::makeKey( b.line1, b.line2, m );
+        });
+
+    return (int)scratch.blocks.size( );
+}
+
+int Duplo::processRolling(const SourceFile& pSource1, const SourceFile& pSource2, Scratch& scratch) const
+{
+    const unsigned int m = pSource1.getNumOfLinesOfCode();
+    const unsigned int n = pSource2.getNumOfLinesOfCode();
+
+    scratch.blocks.clear();
+    return DiagonalScanner::scanRolling(pSource1.getHashHighs(), pSource1.getHashLows(),
+                                        pSource2.getHashHighs(), pSource2.getHashLows(),
+                                        m, n, getMinBlockSize(m, n), pSource1.getFilename() == pSource2.getFilename(),
+                                        scratch.runs, scratch.matrix, scratch.blocks);
+}
+
+void Duplo::processIndexed(const HashIndex& index, const std::vector<SourceFile>& sourceFiles, RowChunk& chunk, Scratch& scratch) const
+{
+    const int file = chunk.file;
+    const SourceFile& pSource1 = sourceFiles[file];
+    const unsigned int m = pSource1.getNumOfLinesOfCode();
+
+    // Seed each line with its occurrences in this and all later files. Within
+    // the file itself only the part below the main diagonal is needed.
+    auto& seeds = scratch.seeds;
+    seeds.clear();
+    for(unsigned int y=0; y<m; y++){
+        const int id = index.getLineId(file, y);
+        for(auto it = index.lowerBound(id, file); it != index.end(id); ++it){
+            if(it->file == file && it->line > (int)y){
+                continue;
+            }
+            seeds.emplace_back(it->file, DiagonalScanner::makeKey(y, it->line, m));
+        }
+    }
+
+    std::sort(seeds.begin(), seeds.end());
+
+    // Grow the runs of each file pair that shares lines
+    auto& keys = scratch.keys;
+    auto it = seeds.begin();
+    while(it != seeds.end()){
+        const int other = it->first;
+        keys.clear();
+        for(; it != seeds.end() && it->first == other; ++it){
+            keys.push_back(it->second);
+        }
+
+        const SourceFile& pSource2 = sourceFiles[other];
+        if(other != file && m_ignoreSameFilename && isSameFilename(pSource1.getFilename(), pSource2.getFilename())){
+            continue;
+        }
+
+        const unsigned int n = pSource2.getNumOfLinesOfCode();
+        m_numComparedPairs++;
+        scratch.blocks.clear();
+        DiagonalScanner::scan(keys.data(), keys.data() + keys.size(), m, getMinBlockSize(m, n),
+                              pSource1.getFilename() == pSource2.getFilename(), scratch.blocks);
+        trimStopLines(pSource1, pSource2, scratch.blocks);
+        for(const auto& block : scratch.blocks){
+            chunk.blocks.emplace_back(other, block);
+        }
+    }
+}
+
+void Duplo::compareRow(const std::vector<SourceFile>& sourceFiles, const HashIndex* index, RowChunk& chunk, Scratch& scratch) const
+{
+    if( index ) {
+
+        processIndexed( *index, sourceFiles, chunk, scratch );
+        return;
+    }
+
+    auto compare = ( m_engine == ENGINE_MATRIX ) ? &Duplo::processMatrix :
+                   ( m_engine == ENGINE_ROLLING ) ? &Duplo::processRolling : &Duplo::process;
+
+    const int i = chunk.file;
+
+    // Either all files of the chunk or only those sharing a fingerprint
+    std::vector<int>& others = scratch.candidates;
+    if( m_fingerprints ) {
+
+        scratch.marked.resize( sourceFiles.size( ), 0 );
+        m_fingerprints->getCandidates( i, scratch.marked, others );
+        others.erase( std::remove_if( others.begin( ), others.end( ), [ & ] ( int j ) { return j < chunk.begin || j >= chunk.end; } ), others.end( ) );
+    } else {
+
+        others.clear( );
+        for(int j=chunk.begin;j<chunk.end;j++){
+            others.push_back( j );
+        }
+    }
+
+    int compared = 0;
+    int pruned = 0;
+    long long cells = 0;
+    for(int j : others){
+
+        if ( j == i || ( m_ignoreSameFilename && isSameFilename( sourceFiles[ i ].getFilename(), sourceFiles[j].getFilename() ) ) == false ) {
+
+            if( isInBaseline( i, j ) ) {
+
+                for(const auto& block : m_baseline->getBlocks( m_baselineIndex[i], m_baselineIndex[j] )){
+                    chunk.blocks.emplace_back(j, block);
+                }
+                continue;
+            }
+
+            // Skip pairs whose sketches show they can't share a block
+            if( j != i && !sourceFiles[ i ].mayShareBlock( sourceFiles[ j ], getMinBlockSize( sourceFiles[ i ].getNumOfLinesOfCode( ), sourceFiles[ j ].getNumOfLinesOfCode( ) ) ) ) {
+                pruned++;
+                continue;
+            }
+
+            (this->*compare)( sourceFiles[ i ], sourceFiles[ j ], scratch );
+            if( m_engine == ENGINE_MATRIX || m_engine == ENGINE_ROLLING ) {
+                trimStopLines( sourceFiles[ i ], sourceFiles[ j ], scratch.blocks );
+                cells += (long long)sourceFiles[ i ].getNumOfLinesOfCode( ) * sourceFiles[ j ].getNumOfLinesOfCode( );
+            }
+            for(const auto& block : scratch.blocks){
+                chunk.blocks.emplace_back(j, block);
+            }
+            compared++;
+        }
+    }
+    m_numComparedPairs += compared;
+    m_numPrunedPairs += pruned;
+    Metrics::add( Metrics::COUNTER_MATRIX_CELLS, cells );
+}
+
+int Duplo::compareAll(const std::vector<SourceFile>& sourceFiles, const HashIndex* index)
+{
+    int blocksTotal = 0;
+
+    // Compare each file with each other
+    for(int i=0;i<(int)sourceFiles.size();i++){
+
+        // With clone classes the files are listed when those are reported
+        if( !m_classes ) {
+            std::cout << sourceFiles[i].getFilename();
+        }
+
+        RowChunk chunk{ i, i, (int)sourceFiles.size() };
+        compareRow( sourceFiles, index, chunk, m_scratch[0] );
+        int blocks = reportRow( chunk, sourceFiles );
+
+        if( !m_classes ) {
+            if(blocks > 0){
+                std::cout << " found: " << blocks << " block(s)" << std::endl;
+            } else {
+                std::cout << " nothing found." << std::endl;
+            }
+        }
+
+        blocksTotal+=blocks;
+    }
+
+    return blocksTotal;
+}
+
+int Duplo::compareAllParallel(const std::vector<SourceFile>& sourceFiles, const HashIndex* index)
+{
+    const int numFiles = (int)sourceFiles.size();
+
+    // Estimate the cost of comparing two files, so that every task gets
+    // about the same amount of work and a few huge files do not end up
+    // in one long task
+    auto cost = [ & ] ( int i, int j ) -> double
+        {
+            if( isInBaseline( i, j ) ) {
+                return 1;
+            }
+            const double m = sourceFiles[i].getNumOfLinesOfCode();
+            const double n = sourceFiles[j].getNumOfLinesOfCode();
+            return ( m_engine == ENGINE_MATRIX || m_engine == ENGINE_ROLLING ) ? m * n : m + n + 1;
+        };
+
+    // Split the rows of the pair space into chunks
+    std::vector<RowChunk> chunks;
+    std::vector<int> firstChunk( numFiles + 1 );
+    if( index || m_fingerprints ) {
+        for(int i=0;i<numFiles;i++){
+            firstChunk[i] = i;
+            chunks.push_back( RowChunk{ i, i, numFiles } );
+        }
+    } else {
+        double total = 0;
+        std::vector<double> suffix( numFiles + 1, 0 );
+        for(int j=numFiles-1;j>=0;j--){
+            suffix[j] = suffix[j+1] + sourceFiles[j].getNumOfLinesOfCode();
+        }
+        for(int i=0;i<numFiles;i++){
+            const double m = sourceFiles[i].getNumOfLinesOfCode();
+            total += ( m_engine == ENGINE_MATRIX || m_engine == ENGINE_ROLLING ) ? m * suffix[i] : ( numFiles - i ) * ( m + 1 ) + suffix[i];
+        }
+
+        const double target = std::max( 1.0, total / ( 16.0 * m_numThreads ) );
+        for(int i=0;i<numFiles;i++){
+            firstChunk[i] = (int)chunks.size();
+            double sum = 0;
+            int begin = i;
+            for(int j=i;j<numFiles;j++){
+                sum += cost( i, j );
+                if( sum >= target ) {
+                    chunks.push_back( RowChunk{ i, begin, j + 1 } );
+                    begin = j + 1;
+                    sum = 0;
+                }
+            }
+            if( begin < numFiles ) {
+                chunks.push_back( RowChunk{ i, begin, numFiles } );
+            }
+        }
+    }
+    firstChunk[numFiles] = (int)chunks.size();
+
+    std::vector<int> remaining( numFiles );
+    for(int i=0;i<numFiles;i++){
+        remaining[i] = firstChunk[i+1] - firstChunk[i];
+    }
+
+    std::mutex mutex;
+    std::condition_variable done;
+
+    ThreadPool pool( m_numThreads );
+    for(auto& chunk : chunks){
+        pool.submit( [ &, this ] ( int worker )
+            {
+                try {
+                    compareRow( sourceFiles, index, chunk, m_scratch[worker] );
+                } catch( ... ) {
+                    chunk.error = std::current_exception( );
+                }
+
+                std::lock_guard<std::mutex> lock( mutex );
+                if( --remaining[chunk.file] == 0 ) {
+                    done.notify_all( );
+                }
+            });
+    }
+
+    int blocksTotal = 0;
+
+    // Report the rows in order as soon as they are complete
+    for(int i=0;i<numFiles;i++){
+        {
+            std::unique_lock<std::mutex> lock( mutex );
+            done.wait( lock, [ & ] { return remaining[i] == 0; } );
+        }
+
+        int blocks = 0;
+        for(int c=firstChunk[i];c<firstChunk[i+1];c++){
+            if( chunks[c].error ) {
+                std::rethrow_exception( chunks[c].error );
+            }
+            blocks += reportRow( chunks[c], sourceFiles );
+            std::vector<std::pair<int, DuplicateBlock>>( ).swap( chunks[c].blocks );
+        }
+
+        // With clone classes the files are listed when those are reported
+        if( !m_classes ) {
+            std::cout << sourceFiles[i].getFilename();
+            if(blocks > 0){
+                std::cout << " found: " << blocks << " block(s)" << std::endl;
+            } else {
+                std::cout << " nothing found." << std::endl;
+            }
+        }
+
+        blocksTotal+=blocks;
+    }
+
+    return blocksTotal;
+}
+
+int Duplo::compareAllSuffix(const std::vector<SourceFile>& sourceFiles, const HashIndex& index)
+{
+    const int numFiles = (int)sourceFiles.size();
+
+    // Concatenate the line ids of all files. Each file ends with a
+    // separator of its own, so that no repeat spans two files.
+    std::vector<int> text;
+    std::vector<int> fileStart( numFiles + 1 );
+    for(int i=0;i<numFiles;i++){
+        fileStart[i] = (int)text.size( );
+        for(int y=0;y<sourceFiles[i].getNumOfLinesOfCode( );y++){
+            text.push_back( numFiles + 1 + index.getLineId( i, y ) );
+        }
+        text.push_back( i + 1 );
+    }
+    fileStart[numFiles] = (int)text.size( );
+    text.push_back( 0 );
+
+    std::vector<int> sa;
+    std::vector<int> lcp;
+    SuffixArray::Build( text, numFiles + 1 + index.getNumOfIds( ), sa );
+    SuffixArray::BuildLcp( text, sa, lcp );
+
+    std::vector<SuffixArray::Repeat> repeats;
+    SuffixArray::GetRepeats( text, sa, lcp, (int)getSmallestMinBlockSize( sourceFiles ), repeats );
+    std::vector<int>( ).swap( lcp );
+
+    // Turn the repeats into blocks of lines, ordered by where they first occur
+    std::vector<CloneClasses::Class> classes;
+    for( auto & repeat : repeats ) {
+
+        std::vector<std::pair<int, int>> blocks;
+        for(int k=repeat.begin;k<repeat.end;k++){
+            const int file = (int)( std::upper_bound( fileStart.begin( ), fileStart.end( ), sa[k] ) - fileStart.begin( ) ) - 1;
+            blocks.emplace_back( file, sa[k] - fileStart[file] );
+        }
+        std::sort( blocks.begin( ), blocks.end( ) );
+
+        if( m_ignoreSameFilename ) {
+
+            // Skip the repeat if it is only found in different files with the same name
+            bool allowed = false;
+            for(size_t b=1;b<blocks.size( ) && !allowed;b++){
+                allowed = ( blocks[b].first == blocks[b-1].first ) ||
+                          !isSameFilename( sourceFiles[blocks[0].first].getFilename( ), sourceFiles[blocks[b].first].getFilename( ) );
+            }
+            if( !allowed ) {
+                continue;
+            }
+        }
+        if( blocks.size( ) < 2 ) {
+            continue;
+        }
+
+        // The repeat starts at its first line that is no stop line
+        int length = repeat.length;
+        const char* stopLines = sourceFiles[blocks[0].first].getStopLines( );
+        int skip = 0;
+        while( stopLines && skip < length && stopLines[blocks[0].second + skip] ) {
+            skip++;
+        }
+        length -= skip;
+        for( auto & block : blocks ) {
+            block.second += skip;
+        }
+
+        // Reported if the block is long enough for the two smallest files
+        std::vector<unsigned int> sizes;
+        for( auto & block : blocks ) {
+            sizes.push_back( sourceFiles[block.first].getNumOfLinesOfCode( ) );
+        }
+        std::nth_element( sizes.begin( ), sizes.begin( ) + 1, sizes.end( ) );
+        if( (unsigned int)length < getMinBlockSize( sizes[0], sizes[1] ) ) {
+            continue;
+        }
+
+        classes.push_back( CloneClasses::Class{ length, std::move( blocks ) } );
+    }
+    std::sort( classes.begin( ), classes.end( ), [ ] ( const CloneClasses::Class & a, const CloneClasses::Class & b ) -> bool
+        {
+            if( a.places[0] != b.places[0] ) {
+                return a.places[0] < b.places[0];
+            }
+            return a.count > b.count;
+        });
+
+    return reportClasses( classes, sourceFiles );
+}
+
+int Duplo::reportClasses(const std::vector<CloneClasses::Class>& classes, const std::vector<SourceFile>& sourceFiles)
+{
+    Metrics::Timer timer( Metrics::PHASE_REPORT );
+    int blocksTotal = 0;
+    size_t c = 0;
+    for(int i=0;i<(int)sourceFiles.size();i++){
+
+        std::cout << sourceFiles[i].getFilename();
+
+        int blocks = 0;
+        for(; c < classes.size( ) && classes[c].places[0].first == i; c++){
+            std::vector<std::pair<const SourceFile*, int>> places;
+            for( auto & place : classes[c].places ) {
+                places.emplace_back( &sourceFiles[place.first], place.second );
+            }
+            _report_generator->reportClass( classes[c].count, places );
+            m_DuplicateLines += classes[c].count * ( (int)places.size( ) - 1 );
+            blocks++;
+        }
+
+        if(blocks > 0){
+            std::cout << " found: " << blocks << " block(s)" << std::endl;
+        } else {
+            std::cout << " nothing found." << std::endl;
+        }
+
+        blocksTotal+=blocks;
+    }
+
+    return blocksTotal;
+}
+
+const std::string Duplo::getFilenamePart(const std::string& fullpath) const {
+    std::string path = StringUtil::substitute('\\', '/', fullpath);
+
+    std::string filename = path;
+
+    std::string::size_type idx = path.rfind('/');
+    if(idx != std::string::npos){
+        filename = path.substr(idx+1, path.size()-idx-1);
+    }
+
+    return filename;
+}
+
+bool Duplo::isSameFilename(const std::string& filename1, const std::string& filename2) const {
+    return (getFilenamePart(filename1) == getFilenamePart(filename2));
+}
+
+void Duplo::loadSourceFiles(std::vector<std::string>& fileNames, std::vector<SourceFile>& sourceFiles, std::vector<double>& seconds)
+{
+    // What is known about one file while it is loaded
+    struct LoadedFile {
+        std::string fileName;
+        std::unique_ptr<SourceFile> file;
+        HashCache::Stamp stamp;
+        bool hasStamp = false;
+        bool fromCache = false;
+        bool fromBaseline = false;
+        double seconds = 0;
+    };
+
+    // The entries keep their place while more files are found
+    std::deque<LoadedFile> loaded;
+    std::mutex loadedMutex;
+
+    // Files are only read if they changed since the cache or the baseline
+    // was written
+    std::unique_ptr<HashCache> cache;
+    if( !m_cacheFileName.empty( ) ) {
+
+        cache = std::make_unique<HashCache>( m_cacheFileName, getHashSettings( ) );
+        cache->load( );
+    }
+    const bool useStamps = cache || m_nextBaseline || ( m_baseline && m_changedFileName.empty( ) );
+
+    // Read, clean and hash one file
+    auto load = [ & ] ( LoadedFile & entry )
+        {
+            auto begin = std::chrono::steady_clock::now( );
+            const std::string & fileName = entry.fileName;
+            if( useStamps && HashCache::GetStamp( fileName, entry.stamp ) ) {
+
+                entry.hasStamp = true;
+            }
+            if( m_baseline ) {
+
+                // A list of changed files is trusted, as a fresh checkout
+                // changes the time of all files
+                if( !m_changedFileName.empty( ) ) {
+                    if( m_changedFiles.count( fileName ) == 0 ) {
+                        entry.file = m_baseline->getFiles( ).get( fileName );
+                    }
+                } else if( entry.hasStamp ) {
+                    entry.file = m_baseline->getFiles( ).get( fileName, entry.stamp );
+                }
+                entry.fromBaseline = ( entry.file != nullptr );
+            }
+            if( !entry.file && cache && entry.hasStamp ) {
+
+                entry.file = cache->get( fileName, entry.stamp );
+                entry.fromCache = ( entry.file != nullptr );
+            }
+            if( !entry.file ) {
+
+                entry.file = std::make_unique<SourceFile>( fileName );
+            }
+            entry.seconds = std::chrono::duration<double>( std::chrono::steady_clock::now( ) - begin ).count( );
+        };
+
+    std::unique_ptr<ThreadPool> pool;
+    if( m_numThreads > 1 ) {
+
+        pool = std::make_unique<ThreadPool>( m_numThreads );
+    }
+    auto add = [ & ] ( const std::string & fileName )
+        {
+            LoadedFile * entry;
+            {
+                std::lock_guard<std::mutex> lock( loadedMutex );
+                loaded.emplace_back( );
+                entry = &loaded.back( );
+            }
+            entry->fileName = fileName;
+            if( pool ) {
+                pool->submit( [ &load, entry ] ( int ) { load( *entry ); } );
+            } else {
+                load( *entry );
+            }
+        };
+
+    // The scanner and the callback are used by the tasks until the wait
+    DirectoryScanner scanner( m_scanRoot, m_includes, m_excludes );
+    const DirectoryScanner::Callback found( add );
+    if( !m_scanRoot.empty( ) ) {
+
+        // The files are loaded while the directories are still read
+        scanner.scan( pool.get( ), found );
+    } else {
+
+        for( const auto & fileName : fileNames ) {
+            add( fileName );
+        }
+    }
+    if( pool ) {
+
+        pool->wait( );
+    }
+
+    // Files found by the scan come in any order, sort them so the
+    // report does not depend on the threads
+    std::vector<LoadedFile*> ordered;
+    for( auto & entry : loaded ) {
+        ordered.push_back( &entry );
+    }
+    if( !m_scanRoot.empty( ) ) {
+
+        std::sort( ordered.begin( ), ordered.end( ), [ ] ( const LoadedFile * a, const LoadedFile * b ) -> bool
+            {
+                return a->fileName < b->fileName;
+            });
+        fileNames.clear( );
+        for( auto * entry : ordered ) {
+            fileNames.push_back( entry->fileName );
+        }
+    }
+
+    const int numFiles = (int)ordered.size();
+    seconds.resize( numFiles );
+    for(int k=0;k<numFiles;k++){
+        seconds[k] = ordered[k]->seconds;
+    }
+
+    // Store the current state of the files
+    if( cache ) {
+
+        m_numCachedFiles = 0;
+        cache->clear( );
+        for( auto * entry : ordered ) {
+            if( entry->hasStamp ) {
+
+                cache->put( *entry->file, entry->stamp );
+            }
+            m_numCachedFiles += entry->fromCache;
+        }
+        if( !cache->save( ) ) {
+
+            std::cout << "Error: Can't write cache file: " << m_cacheFileName << "\n";
+        }
+    }
+
+    // Keep the files in the order of the list, empty ones are skipped
+    m_numBaselineFiles = 0;
+    m_baselineIndex.clear( );
+    for( auto * entry : ordered ){
+
+        auto & sf = entry->file;
+        if( m_nextBaseline && entry->hasStamp ) {
+
+            m_nextBaseline->getFiles( ).put( *sf, entry->stamp );
+        }
+        if(sf->getNumOfLinesOfFile() > 0){
+
+            if( m_nextBaseline ) {
+                m_nextBaseline->addFileName( entry->fileName );
+            }
+            m_baselineIndex.push_back( entry->fromBaseline ? m_baseline->getFileIndex( entry->fileName ) : -1 );
+            sourceFiles.push_back( std::move( *sf ) );
+        }
+        m_numBaselineFiles += entry->fromBaseline;
+        sf.reset( );
+    }
+}
+
+void Duplo::loadBaseline()
+{
+    if( !m_baselineFileName.empty( ) ) {
+
+        m_baseline = std::make_unique<Baseline>( getBlockSettings( ), getHashSettings( ) );
+        if( !m_baseline->load( m_baselineFileName ) ) {
+
+            // Missing or made with other settings, compare all files
+            m_baseline.reset( );
+        }
+    }
+
+    if( m_baseline && !m_changedFileName.empty( ) ) {
+
+        TextFile listOfFiles( m_changedFileName.c_str( ) );
+        std::vector<std::string> lines;
+        listOfFiles.readLines( lines, true );
+        m_changedFiles.clear( );
+        for( auto & line: lines ) {
+
+            if( !line.empty( ) ) {
+
+                m_changedFiles.insert( line );
+            }
+        }
+    }
+
+    if( !m_saveBaselineFileName.empty( ) ) {
+
+        m_nextBaseline = std::make_unique<Baseline>( getBlockSettings( ), getHashSettings( ) );
+    }
+}
+
+void Duplo::findStopLines(std::vector<SourceFile>& sourceFiles)
+{
+    const int numFiles = (int)sourceFiles.size( );
+
+    // Take each distinct line of each file once
+    struct Line {
+        long long high;
+        long long low;
+        int file;
+        int line;
+    };
+    std::vector<Line> lines;
+    for(int f=0;f<numFiles;f++){
+        const std::vector<int>& order = sourceFiles[f].getLinesByHash( );
+        const long long* highs = sourceFiles[f].getHashHighs( );
+        const long long* lows = sourceFiles[f].getHashLows( );
+        for(size_t k=0;k<order.size( );k++){
+            const int y = order[k];
+            if( k == 0 || highs[y] != highs[order[k-1]] || lows[y] != lows[order[k-1]] ) {
+                lines.push_back( Line{ highs[y], lows[y], f, y } );
+            }
+        }
+    }
+    std::sort( lines.begin( ), lines.end( ), [ ] ( const Line & a, const Line & b ) -> bool
+        {
+            if( a.high != b.high ) {
+                return a.high < b.high;
+            }
+            if( a.low != b.low ) {
+                return a.low < b.low;
+            }
+            return a.file < b.file;
+        });
+
+    // The number of files of each line, and the lines in too many files
+    std::vector<std::pair<int, size_t>> frequencies;
+    std::vector<std::pair<long long, long long>> stopHashes;
+    for(size_t k=0;k<lines.size( );){
+        size_t end = k + 1;
+        while( end < lines.size( ) && lines[end].high == lines[k].high && lines[end].low == lines[k].low ) {
+            end++;
+        }
+        const int numOfFiles = (int)( end - k );
+        frequencies.emplace_back( numOfFiles, k );
+        if( numOfFiles > m_stopFrequency ) {
+            stopHashes.emplace_back( lines[k].high, lines[k].low );
+        }
+        k = end;
+    }
+
+    // The blocks of unchanged pairs depend on the stop lines of all
+    // files, the baseline is only of use if they are the same
+    unsigned long long digestHigh = 0;
+    unsigned long long digestLow = 0;
+    if( !stopHashes.empty( ) ) {
+        HashUtil::getMurmur3Sum( (const unsigned char*)stopHashes.data( ), (int)( stopHashes.size( ) * sizeof( stopHashes[0] ) ), digestHigh, digestLow );
+    }
+    if( m_nextBaseline ) {
+        m_nextBaseline->setStopLines( digestHigh, digestLow );
+    }
+    if( m_baseline && !m_baseline->hasStopLines( digestHigh, digestLow ) ) {
+        std::cout << "Baseline: stop lines changed, comparing all files\n\n";
+        m_baseline.reset( );
+    }
+
+    for( auto & sf : sourceFiles ) {
+        const int n = sf.getNumOfLinesOfCode( );
+        const long long* highs = sf.getHashHighs( );
+        const long long* lows = sf.getHashLows( );
+        std::vector<char> stopLines( n, 0 );
+        bool any = false;
+        for(int y=0;y<n;y++){
+            stopLines[y] = std::binary_search( stopHashes.begin( ), stopHashes.end( ), std::make_pair( highs[y], lows[y] ) );
+            any = any || stopLines[y];
+        }
+        if( any ) {
+            sf.setStopLines( std::move( stopLines ) );
+        }
+    }
+
+    const int numTop = std::min( (int)frequencies.size( ), m_numTopStopLines );
+    std::partial_sort( frequencies.begin( ), frequencies.begin( ) + numTop, frequencies.end( ), [ ] ( const std::pair<int, size_t> & a, const std::pair<int, size_t> & b ) -> bool
+        {
+            return a.first > b.first || ( a.first == b.first && a.second < b.second );
+        });
+
+    std::cout << "Stop lines: " << stopHashes.size( ) << " distinct lines found in more than " << m_stopFrequency << " files\n";
+    if( numTop > 0 ) {
+
+        std::cout << "Most frequent lines:\n";
+        for(int k=0;k<numTop;k++){
+            const Line & line = lines[frequencies[k].second];
+            std::cout << std::setw( 10 ) << frequencies[k].first << " files  " << sourceFiles[line.file].getLineText( line.line ) << "\n";
+        }
+    }
+    std::cout << "\n";
+}
+
+void Duplo::reportLoadTimes(const std::vector<std::string>& fileNames, const std::vector<double>& seconds) const
+{
+    const int numFiles = (int)fileNames.size();
+
+    // Show the files that were the most expensive to load
+    std::vector<int> slowest( numFiles );
+    for(int k=0;k<numFiles;k++){
+        slowest[k] = k;
+    }
+    const int numSlowest = std::min( numFiles, SLOWEST_FILES );
+    std::partial_sort( slowest.begin( ), slowest.begin( ) + numSlowest, slowest.end( ), [ & ] ( int a, int b ) -> bool
+        {
+            return seconds[a] > seconds[b];
+        });
+
+    if( numSlowest > 0 ) {
+
+        std::cout << "Slowest files to load:\n";
+        for(int k=0;k<numSlowest;k++){
+            std::cout << std::setw( 10 ) << std::fixed << std::setprecision( 3 ) << seconds[slowest[k]] * 1000 << " ms  "
+                      << fileNames[slowest[k]] << "\n";
+        }
+        std::cout.unsetf( std::ios::floatfield );
+        std::cout << std::setprecision( 6 ) << "\n";
+    }
+}
+
+void Duplo::run(std::string outputFileName) {
+
+    std::ofstream outfile(outputFileName.c_str(), std::ios::out|std::ios::binary);
+    
+    if(!outfile.is_open()) {
+        std::cout << "Error: Can't open file: " << outputFileName << std::endl;
+        return;
+    }
+
+    // Time is wall time, the CPU time of the threads is only in the stats
+    Metrics::setEnabled( !m_statsFileName.empty( ) );
+    const double start = Metrics::GetWallTime( );
+    const double cpuStart = Metrics::GetCpuTime( true );
+
+    // The report is buffered in large blocks and only flushed at its end
+    ReportSink sink( outfile, m_asyncReport );
+    std::ostream report( &sink );
+
+    _report_generator = GeneratorFactory::Create( m_format, report, m_reportText );
+
+    _report_generator->writeHeader( m_minBlockSize, m_minChars, m_ignorePrepStuff, m_ignoreSameFilename, VERSION );
+
+
+    std::cout << "Loading and hashing files ... ";
+    std::cout.flush();
+
+    
+    std::vector<std::string> lines;
+    if(m_scanRoot.empty()){
+        Metrics::Timer timer( Metrics::PHASE_LIST );
+        TextFile listOfFiles(m_listFileName.c_str());
+        listOfFiles.readLines(lines, true);
+    }
+    
+    std::vector<SourceFile> sourceFiles;
+    sourceFiles.reserve( lines.size( ) );
+    
+    int files = 0;
+    int locsTotal = 0;
+
+
+    //Set values for processing of files.
+    SourceFile::setMinChars( m_minChars );
+    SourceFile::setIgnorePreprocessor( m_ignorePrepStuff );
+    SourceFile::setNormalizeTokens( m_normalizeTokens );
+    SourceLine::setHashFunction( m_hashFunction );
+
+    // Create vector with all source files
+    std::vector<std::string> fileNames;
+    for( auto & line: lines ) {
+
+        if(!line.empty()){
+
+            fileNames.push_back( line );
+        }
+    }
+
+    Metrics::Timer loadTimer( Metrics::PHASE_LOAD, true );
+    loadBaseline( );
+
+    std::vector<double> loadSeconds;
+    loadSourceFiles( fileNames, sourceFiles, loadSeconds );
+    loadTimer.stop( );
+
+    for( auto & sf: sourceFiles ) {
+
+        files++;
+        locsTotal+=sf.getNumOfLinesOfFile();
+    }
+
+    auto it= std::max_element( sourceFiles.begin( ), sourceFiles.end( ), [ ] ( SourceFile & sf1, SourceFile & sf2 ) -> bool
+            {
+              return sf1.getNumOfLinesOfCode( ) < sf2.getNumOfLinesOfCode( );
+            });
+
+    m_maxLinesPerFile = ( it != sourceFiles.end( ) ) ? it->getNumOfLinesOfCode( ) : 0;
+
+    std::cout << "done.\n\n";
+
+    if( !m_cacheFileName.empty( ) ) {
+
+        std::cout << "Hash cache: " << m_numCachedFiles << " of " << fileNames.size( ) << " files unchanged\n\n";
+    }
+
+    if( !m_baselineFileName.empty( ) ) {
+
+        if( m_baseline ) {
+            std::cout << "Baseline: " << m_numBaselineFiles << " of " << fileNames.size( ) << " files unchanged\n\n";
+        } else {
+            std::cout << "Baseline: " << m_baselineFileName << " not usable, comparing all files\n\n";
+        }
+    }
+
+    reportLoadTimes( fileNames, loadSeconds );
+
+    if( m_stopFrequency > 0 ) {
+
+        Metrics::Timer stopLinesTimer( Metrics::PHASE_STOP_LINES );
+        findStopLines( sourceFiles );
+    }
+
+    // The rows are reported while the files are compared, that time is
+    // taken out of the compare phase
+    Metrics::Timer compareTimer( Metrics::PHASE_COMPARE, true );
+    const double reportWall = Metrics::getWall( Metrics::PHASE_REPORT );
+    const double reportCpu = Metrics::getCpu( Metrics::PHASE_REPORT );
+
+    m_scratch = std::vector<Scratch>( m_numThreads );
+
+    // The index engine seeds a file against all later files at once, so it
+    // can't take unchanged pairs from a baseline. With one the files are
+    // compared pair by pair like the sparse engine does.
+    std::unique_ptr<HashIndex> index;
+    if(m_engine == ENGINE_SUFFIX || (m_engine == ENGINE_INDEX && !m_baseline)){
+
+        // Build the line hash index over all files
+        index = std::make_unique<HashIndex>( sourceFiles );
+    } else if(m_engine == ENGINE_WINNOW){
+
+        // Fingerprint all files, only files sharing one are compared
+        m_fingerprints = std::make_unique<FingerprintIndex>( sourceFiles, getSmallestMinBlockSize( sourceFiles ), m_numThreads );
+    } else if(m_engine == ENGINE_MATRIX){
+
+        // Generate matrix large enough for all files, one per thread. If
+        // that is more than the memory allows, larger files are compared
+        // in tiles and the matrix only needs to hold one.
+        matrix_size = (long)m_maxLinesPerFile * ( ( m_maxLinesPerFile + 63 ) / 64 );
+        const long maxSize = (long)m_maxMemory * 1024 * 1024 / sizeof( unsigned long long ) / m_numThreads;
+        if( matrix_size > maxSize ) {
+            matrix_size = std::max( maxSize, (long)MATRIX_TILE_SIZE * ( MATRIX_TILE_SIZE / 64 ) );
+            std::cout << "Matrix: " << matrix_size * sizeof( unsigned long long ) / 1024 << " KB per thread, larger file pairs are compared in tiles\n";
+        }
+        for( auto & scratch : m_scratch ) {
+            scratch.matrix = std::vector<unsigned long long>( matrix_size, 0 );
+        }
+        std::cout << "Max size of long = " << std::numeric_limits<long>::max( ) << endl;
+        std::cout << "Try to reserve a vector with " << matrix_size << " elements" << endl;
+        std::cout << "Maximum size of a 'vector' is " << m_scratch[0].matrix.max_size() << "\n";
+    }
+
+
+    if( m_cloneClasses && m_engine != ENGINE_SUFFIX ) {
+
+        // Collect the blocks of all pairs, to report them as classes
+        m_classes = std::make_unique<CloneClasses>( );
+    }
+
+    int blocksTotal = 0;
+
+    try
+    {
+        if( m_engine == ENGINE_SUFFIX ) {
+            blocksTotal = compareAllSuffix( sourceFiles, *index );
+        } else if( m_numThreads > 1 ) {
+            blocksTotal = compareAllParallel( sourceFiles, index.get( ) );
+        } else {
+            blocksTotal = compareAll( sourceFiles, index.get( ) );
+        }
+    }
+    catch( std::out_of_range & exc )
+    {
+        cout << "Out range error " << exc.what( ) << endl << endl;
+    }
+
+    if( m_classes ) {
+
+        m_classes->build( );
+        blocksTotal = reportClasses( m_classes->getClasses( ), sourceFiles );
+        std::cout << "Clone classes: " << m_classes->getClasses( ).size( ) << " classes from "
+                  << m_classes->getNumOfBlocks( ) << " blocks\n";
+        m_classes.reset( );
+    }
+
+    compareTimer.stop( );
+    Metrics::addTime( Metrics::PHASE_COMPARE, reportWall - Metrics::getWall( Metrics::PHASE_REPORT ),
+                      reportCpu - Metrics::getCpu( Metrics::PHASE_REPORT ) );
+
+
+
+    if( m_fingerprints ) {
+
+        const long long numPairs = (long long)files * ( files + 1 ) / 2;
+        std::cout << "Winnowing: " << m_fingerprints->getNumOfFingerprints( ) << " fingerprints, "
+                  << m_numComparedPairs << " of " << numPairs << " file pairs compared\n";
+    }
+
+    if( m_numPrunedPairs > 0 ) {
+
+        std::cout << "Sketches: " << m_numPrunedPairs << " of " << m_numPrunedPairs + m_numComparedPairs << " file pairs pruned\n";
+    }
+
+    // Only the join of the lines on their hash counts the matches, the
+    // other engines trim stop lines off the blocks they found
+    if( m_stopFrequency > 0 && m_numLineMatches > 0 ) {
+
+        std::cout << "Stop lines: " << m_numStopMatches << " of " << m_numLineMatches << " line matches skipped\n";
+    }
+
+    if( m_nextBaseline && !m_nextBaseline->save( m_saveBaselineFileName ) ) {
+
+        std::cout << "Error: Can't write baseline file: " << m_saveBaselineFileName << "\n";
+    }
+
+    const double duration = Metrics::GetWallTime( ) - start;
+    std::cout << "Time: "<< duration << " seconds" << std::endl;
+
+    {
+        Metrics::Timer timer( Metrics::PHASE_REPORT );
+        _report_generator->writeSummary( files, blocksTotal, locsTotal, m_DuplicateLines, duration );
+        _report_generator.reset( );
+    }
+
+    if( Metrics::isEnabled( ) ) {
+
+        const long long numPairs = (long long)files * ( files + 1 ) / 2;
+        Metrics::add( Metrics::COUNTER_FILES, files );
+        Metrics::add( Metrics::COUNTER_PAIRS_COMPARED, m_numComparedPairs );
+        Metrics::add( Metrics::COUNTER_PAIRS_SKIPPED, ( m_engine == ENGINE_SUFFIX ) ? 0 : numPairs - m_numComparedPairs );
+        Metrics::add( Metrics::COUNTER_PAIRS_PRUNED, m_numPrunedPairs );
+        Metrics::add( Metrics::COUNTER_BLOCKS, blocksTotal );
+        if( !Metrics::save( m_statsFileName, VERSION, m_numThreads, Metrics::GetWallTime( ) - start, Metrics::GetCpuTime( true ) - cpuStart ) ) {
+
+            std::cout << "Error: Can't write stats file: " << m_statsFileName << "\n";
+        }
+    }
+}
@@ -1,69 +1,307 @@
-/** \class Duplo
- * Duplo, main class
- *
- * @author  Christian Ammann (cammann@giants.ch)
- * @date  16/05/05
- *
- * This program is free software; you can redistribute it and/or modify
- * it under the terms of the GNU General Public License as published by
- * the Free Software Foundation; either version 2 of the License, or
- * (at your option) any later version.
- * 
- * This program is distributed in the hope that it will be useful,
- * but WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
- * GNU General Public License for more details.
- * 
- * You should have received a copy of the GNU General Public License
- * along with this program; if not, write to the Free Software
- * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
- */
-
-#ifndef _DUPLO_H_
-#define _DUPLO_H_
-
-#include <iostream>
-#include <memory>
-#include <string>
-#include <vector>
-
-class SourceFile;
-class IOutGenerator;
-
-const std::string VERSION = "0.2.0";
-
-class Duplo {
-protected:
-    std::string m_listFileName;
-    unsigned int m_minBlockSize;
-    unsigned int m_blockPercentThreshold;
-    unsigned int m_minChars;
-    bool m_ignorePrepStuff;
-    bool m_ignoreSameFilename;
-    int m_maxLinesPerFile;
-    int m_DuplicateLines;
-    bool m_Xml;
-    //std::unique_ptr< unsigned char [ ] > m_pMatrix;
-    std::vector<bool> m_pMatrix;
-    std::unique_ptr< IOutGenerator> _report_generator;
-    long matrix_size = 0;
-
-    void reportSeq(int line1, int line2, int count, const SourceFile& pSource1, const SourceFile& pSource2, std::ostream& outFile);
-    int process( const SourceFile& pSource1, const SourceFile& pSource2, std::ostream& outFile);
-
-    const std::string getFilenamePart(const std::string& fullpath) const;
-    bool isSameFilename(const std::string& filename1, const std::string& filename2) const;
-
-public:
-    Duplo(
-        const std::string& listFileName,     
-        unsigned int blockPercentThreshold, 
-        unsigned int minBlockSize, 
-        unsigned int minChars, 
-        bool ignorePrepStuff, bool ignoreSameFilename, bool Xml);
-    ~Duplo();
-    void run(std::string outputFileName);
-};
-
-#endif
-
+/** \class Duplo
+ * Duplo, main class
+ *
+ * @author  Christian Ammann (cammann@giants.ch)
+ * @date  16/05/05
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _DUPLO_H_
+#define _DUPLO_H_
+
+#include <atomic>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "CloneClasses.h"
+#include "DuplicateBlock.h"
+#include "HashUtil.h"
+#include "GeneratorFactory.h"
+
+class SourceFile;
+class IOutGenerator;
+class HashIndex;
+class Baseline;
+class FingerprintIndex;
+
+const std::string VERSION = "0.2.0";
+
+// Number of files listed as the most expensive to load
+const int SLOWEST_FILES = 10;
+
+// Number of stop lines listed by default
+const int TOP_STOP_LINES = 10;
+
+// Memory in MB the matrix engine may use by default, for all threads
+const int MAX_MEMORY = 1024;
+
+// Lines per side of the tiles larger file pairs are compared in
+const unsigned int MATRIX_TILE_SIZE = 1024;
+
+class Duplo {
+public:
+    enum ENGINE
+    {
+        ENGINE_SPARSE,
+        ENGINE_MATRIX,
+        ENGINE_INDEX,
+        ENGINE_SUFFIX,
+        ENGINE_WINNOW,
+        ENGINE_ROLLING
+    };
+
+protected:
+    std::string m_listFileName;
+    std::string m_scanRoot;
+    std::string m_includes;
+    std::string m_excludes;
+    unsigned int m_minBlockSize;
+    unsigned int m_blockPercentThreshold;
+    unsigned int m_minChars;
+    bool m_ignorePrepStuff;
+    bool m_ignoreSameFilename;
+    int m_maxLinesPerFile;
+    int m_DuplicateLines;
+    GeneratorFactory::FORMAT m_format;
+    ENGINE m_engine;
+    int m_numThreads;
+    HashUtil::HASH m_hashFunction;
+    std::string m_cacheFileName;
+    int m_numCachedFiles;
+    std::string m_baselineFileName;
+    std::string m_changedFileName;
+    std::string m_saveBaselineFileName;
+    std::unique_ptr<Baseline> m_baseline;
+    std::unique_ptr<Baseline> m_nextBaseline;
+    std::unordered_set<std::string> m_changedFiles;
+    std::vector<int> m_baselineIndex;
+    int m_numBaselineFiles;
+    std::unique_ptr< IOutGenerator> _report_generator;
+    long matrix_size = 0;
+    std::unique_ptr<FingerprintIndex> m_fingerprints;
+    int m_stopFrequency;
+    int m_numTopStopLines;
+    int m_maxMemory;
+    bool m_asyncReport;
+    bool m_reportText;
+    bool m_normalizeTokens;
+    std::string m_statsFileName;
+    bool m_cloneClasses;
+    // The blocks of all pairs while comparing with clone classes
+    std::unique_ptr<CloneClasses> m_classes;
+
+    // Counted by the engines while comparing
+    mutable std::atomic<long long> m_numComparedPairs;
+    mutable std::atomic<long long> m_numPrunedPairs;
+    mutable std::atomic<long long> m_numLineMatches;
+    mutable std::atomic<long long> m_numStopMatches;
+
+    /**
+     * Buffers the engines work in, one per worker thread
+     */
+    struct Scratch {
+        // One bit per line pair, each row padded to whole words
+        std::vector<unsigned long long> matrix;
+        // Length of the run on each diagonal, carried from tile to tile
+        std::vector<int> runs;
+        std::vector<std::pair<int, unsigned long long>> seeds;
+        std::vector<unsigned long long> keys;
+        std::vector<DuplicateBlock> blocks;
+        std::vector<char> marked;
+        std::vector<int> candidates;
+    };
+    std::vector<Scratch> m_scratch;
+
+    /**
+     * Blocks found between one file and a range of files following it
+     */
+    struct RowChunk {
+        int file;
+        int begin;
+        int end;
+        std::vector<std::pair<int, DuplicateBlock>> blocks;
+        std::exception_ptr error;
+
+        RowChunk(int file, int begin, int end) :
+            file(file), begin(begin), end(end), blocks(), error() {}
+    };
+
+    void reportSeq(int line1, int line2, int count, const SourceFile& pSource1, const SourceFile& pSource2);
+    int reportRow(const RowChunk& chunk, const std::vector<SourceFile>& sourceFiles);
+    unsigned int getMinBlockSize(unsigned int m, unsigned int n) const;
+    unsigned int getSmallestMinBlockSize(const std::vector<SourceFile>& sourceFiles) const;
+    std::string getHashSettings() const;
+    std::string getBlockSettings() const;
+    bool isInBaseline(int file1, int file2) const;
+    void trimStopLines(const SourceFile& pSource1, const SourceFile& pSource2, std::vector<DuplicateBlock>& blocks) const;
+    void findStopLines(std::vector<SourceFile>& sourceFiles);
+    int process( const SourceFile& pSource1, const SourceFile& pSource2, Scratch& scratch) const;
+    int processMatrix( const SourceFile& pSource1, const SourceFile& pSource2, Scratch& scratch) const;
+    int processTiled( const SourceFile& pSource1, const SourceFile& pSource2, Scratch& scratch) const;
+    int processRolling( const SourceFile& pSource1, const SourceFile& pSource2, Scratch& scratch) const;
+    void processIndexed(const HashIndex& index, const std::vector<SourceFile>& sourceFiles, RowChunk& chunk, Scratch& scratch) const;
+    void compareRow(const std::vector<SourceFile>& sourceFiles, const HashIndex* index, RowChunk& chunk, Scratch& scratch) const;
+    int compareAll(const std::vector<SourceFile>& sourceFiles, const HashIndex* index);
+    int compareAllParallel(const std::vector<SourceFile>& sourceFiles, const HashIndex* index);
+    int compareAllSuffix(const std::vector<SourceFile>& sourceFiles, const HashIndex& index);
+    /**
+     * @brief Report the classes of blocks, listing each file with the
+     * number of classes starting in it
+     */
+    int reportClasses(const std::vector<CloneClasses::Class>& classes, const std::vector<SourceFile>& sourceFiles);
+
+    /**
+     * @brief Read, clean and hash the files, on several threads if enabled
+     *
+     * The files are appended in the order of the names, files without
+     * lines are left out. seconds gets the time each file took. When a
+     * directory is scanned its files are loaded as they are found, and
+     * fileNames gets their sorted names.
+     */
+    void loadSourceFiles(std::vector<std::string>& fileNames, std::vector<SourceFile>& sourceFiles, std::vector<double>& seconds);
+    void loadBaseline();
+    void reportLoadTimes(const std::vector<std::string>& fileNames, const std::vector<double>& seconds) const;
+
+    const std::string getFilenamePart(const std::string& fullpath) const;
+    bool isSameFilename(const std::string& filename1, const std::string& filename2) const;
+
+public:
+    Duplo(
+        const std::string& listFileName,     
+        unsigned int blockPercentThreshold, 
+        unsigned int minBlockSize, 
+        unsigned int minChars, 
+        bool ignorePrepStuff, bool ignoreSameFilename, bool Xml);
+    ~Duplo();
+
+    /**
+     * @brief Select the engine that finds the matching lines of file pairs
+     *
+     * ENGINE_SPARSE compares every file with every other file by joining
+     * their lines on the hash, ENGINE_MATRIX does the same by filling a
+     * matrix with all m*n line comparisons, ENGINE_INDEX only compares
+     * files that share at least one line. ENGINE_SUFFIX finds the maximal
+     * repeats in all files at once and reports each with all the places
+     * it occurs, instead of one block per file pair. ENGINE_WINNOW only
+     * compares files that share a fingerprint of their line sequences.
+     * ENGINE_ROLLING compares every pair like ENGINE_MATRIX, but keeps
+     * only one row of run lengths instead of the matrix.
+     */
+    void setEngine(ENGINE engine);
+    static bool GetEngine(const std::string& name, ENGINE& engine);
+
+    /**
+     * @brief Set the number of threads loading and comparing files
+     *
+     * Reports come out in the same order whatever the number of threads.
+     */
+    void setNumOfThreads(int numThreads);
+
+    /**
+     * @brief Select the function lines are hashed with
+     */
+    void setHashFunction(HashUtil::HASH hash);
+
+    /**
+     * @brief Keep the line hashes in a file, so unchanged files are not
+     * read and hashed again by the next run
+     */
+    void setCacheFile(const std::string& fileName);
+
+    /**
+     * @brief Only compare the file pairs with a changed file, the blocks of
+     * the other pairs are taken from the baseline of a previous run
+     *
+     * The files listed in changedFileName are the changed ones. Without
+     * that list, files that differ in size or time from the baseline are.
+     */
+    void setBaseline(const std::string& fileName, const std::string& changedFileName);
+
+    /**
+     * @brief Write the files and blocks of this run as the baseline of a
+     * later one
+     */
+    void setSaveBaseline(const std::string& fileName);
+
+    /**
+     * @brief Lines found in more than frequency files may not start a
+     * block, they may still be part of one
+     *
+     * The numOfTop most frequent lines are listed. A frequency of 0 turns
+     * the filter off.
+     */
+    void setStopLines(int frequency, int numOfTop);
+
+    /**
+     * @brief Limit the memory of the matrix engine to megaBytes for all
+     * threads
+     *
+     * File pairs whose matrix does not fit are compared in tiles of
+     * MATRIX_TILE_SIZE lines per side instead.
+     */
+    void setMaxMemory(int megaBytes);
+
+    /**
+     * @brief Take the source files below the directory root instead of
+     * the ones of the file list
+     *
+     * @param includes, excludes comma separated glob patterns, see
+     *        DirectoryScanner
+     */
+    void setScanRoot(const std::string& root, const std::string& includes, const std::string& excludes);
+
+    /**
+     * @brief Write the report file on a thread of its own
+     */
+    void setAsyncReport(bool async);
+
+    /**
+     * @brief Select the format of the report, instead of text or XML
+     *
+     * @param withText keep the texts of the lines, otherwise only their
+     *        places. Only the binary format can leave them out.
+     */
+    void setReportFormat(GeneratorFactory::FORMAT format, bool withText);
+
+    /**
+     * @brief Compare lines by their tokens, identifiers and literals
+     * replaced by their class, to find clones with renamed names
+     */
+    void setNormalizeTokens(bool normalize);
+
+    /**
+     * @brief Write the time of each phase and counters of the work done
+     * to fileName as JSON, see Metrics
+     */
+    void setStatsFile(const std::string& fileName);
+
+    /**
+     * @brief Merge the blocks of all file pairs into clone classes, and
+     * report each class once with all its places, see CloneClasses
+     *
+     * The suffix engine always reports classes.
+     */
+    void setCloneClasses(bool classes);
+
+    void run(std::string outputFileName);
+};
+
+#endif
+
@@ -0,0 +1,197 @@
+/**
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "FingerprintIndex.h"
+
+#include "SourceFile.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <deque>
+#include <utility>
+
+namespace {
+    const unsigned long long BASE = 0x100000001b3ULL;
+
+    // Spread the bits of the rolling hash, so that the smallest values
+    // are picked evenly
+    unsigned long long mix(unsigned long long k){
+        k ^= k >> 33;
+        k *= 0xff51afd7ed558ccdULL;
+        k ^= k >> 33;
+        k *= 0xc4ceb9fe1a85ec53ULL;
+        k ^= k >> 33;
+        return k;
+    }
+}
+
+FingerprintIndex::FingerprintIndex(const std::vector<SourceFile>& sourceFiles, unsigned int minBlockSize, int numThreads) :
+    m_numFingerprints(0)
+{
+    const int numFiles = (int)sourceFiles.size();
+
+    int k;
+    int w;
+    GetParameters(minBlockSize, k, w);
+
+    std::vector<std::vector<unsigned long long>> fingerprints(numFiles);
+    if(numThreads > 1){
+        ThreadPool pool(numThreads);
+        for(int i = 0; i < numFiles; i++){
+            pool.submit([ &, i ] ( int ) { Winnow(sourceFiles[i], k, w, fingerprints[i]); });
+        }
+        pool.wait();
+    } else {
+        for(int i = 0; i < numFiles; i++){
+            Winnow(sourceFiles[i], k, w, fingerprints[i]);
+        }
+    }
+
+    // Collect the distinct (fingerprint, file) pairs
+    std::vector<std::pair<unsigned long long, int>> entries;
+    m_selfRepeat.assign(numFiles, 0);
+    for(int i = 0; i < numFiles; i++){
+        const auto& prints = fingerprints[i];
+        m_numFingerprints += (long long)prints.size();
+        for(size_t j = 0; j < prints.size(); j++){
+            if(j > 0 && prints[j] == prints[j - 1]){
+                m_selfRepeat[i] = 1;
+                continue;
+            }
+            entries.emplace_back(prints[j], i);
+        }
+        std::vector<unsigned long long>().swap(fingerprints[i]);
+    }
+    std::sort(entries.begin(), entries.end());
+
+    // Number the fingerprints and list the files of each
+    std::vector<int> ids(entries.size());
+    std::vector<int> numIds(numFiles, 0);
+    m_files.reserve(entries.size());
+    for(size_t e = 0; e < entries.size(); e++){
+        if(e == 0 || entries[e].first != entries[e - 1].first){
+            m_bucketStart.push_back((int)e);
+        }
+        ids[e] = (int)m_bucketStart.size() - 1;
+        m_files.push_back(entries[e].second);
+        numIds[entries[e].second]++;
+    }
+    m_bucketStart.push_back((int)entries.size());
+
+    // And the fingerprints of each file
+    m_fileStart.assign(numFiles + 1, 0);
+    for(int i = 0; i < numFiles; i++){
+        m_fileStart[i + 1] = m_fileStart[i] + numIds[i];
+    }
+    m_fileIds.resize(entries.size());
+    std::vector<int> next(m_fileStart.begin(), m_fileStart.end() - 1);
+    for(size_t e = 0; e < entries.size(); e++){
+        m_fileIds[next[entries[e].second]++] = ids[e];
+    }
+}
+
+void FingerprintIndex::getCandidates(int file, std::vector<char>& marked, std::vector<int>& candidates) const
+{
+    candidates.clear();
+    if(m_selfRepeat[file]){
+        candidates.push_back(file);
+    }
+
+    for(int f = m_fileStart[file]; f < m_fileStart[file + 1]; f++){
+        const int id = m_fileIds[f];
+        const int* end = m_files.data() + m_bucketStart[id + 1];
+        for(const int* it = std::upper_bound(m_files.data() + m_bucketStart[id], end, file); it != end; ++it){
+            if(!marked[*it]){
+                marked[*it] = 1;
+                candidates.push_back(*it);
+            }
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end());
+    for(int other : candidates){
+        marked[other] = 0;
+    }
+}
+
+long long FingerprintIndex::getNumOfFingerprints() const
+{
+    return m_numFingerprints;
+}
+
+void FingerprintIndex::GetParameters(unsigned int minBlockSize, int& k, int& w)
+{
+    const int t = std::max(1, (int)minBlockSize);
+    k = (t + 1) / 2;
+    w = t - k + 1;
+}
+
+void FingerprintIndex::Winnow(const SourceFile& sourceFile, int k, int w, std::vector<unsigned long long>& fingerprints)
+{
+    fingerprints.clear();
+
+    const int n = sourceFile.getNumOfLinesOfCode();
+    if(n < k){
+        return;
+    }
+
+    const long long* highs = sourceFile.getHashHighs();
+    const long long* lows = sourceFile.getHashLows();
+    auto value = [ & ] ( int i ) -> unsigned long long
+        {
+            return (unsigned long long)highs[i] ^ ((unsigned long long)lows[i] * 0x9e3779b97f4a7c15ULL);
+        };
+
+    // BASE^(k-1), to take the oldest line out of the rolling hash
+    unsigned long long power = 1;
+    for(int i = 1; i < k; i++){
+        power *= BASE;
+    }
+
+    std::vector<unsigned long long> runs(n - k + 1);
+    unsigned long long hash = 0;
+    for(int i = 0; i < n; i++){
+        if(i >= k){
+            hash -= value(i - k) * power;
+        }
+        hash = hash * BASE + value(i);
+        if(i >= k - 1){
+            runs[i - k + 1] = mix(hash);
+        }
+    }
+
+    // Keep the smallest hash of each window, the rightmost one on ties.
+    // The deque holds the candidates of the window in increasing order.
+    const int numRuns = (int)runs.size();
+    const int window = std::min(w, numRuns);
+    std::deque<int> candidates;
+    int last = -1;
+    for(int i = 0; i < numRuns; i++){
+        while(!candidates.empty() && runs[candidates.back()] >= runs[i]){
+            candidates.pop_back();
+        }
+        candidates.push_back(i);
+        if(candidates.front() <= i - window){
+            candidates.pop_front();
+        }
+        if(i >= window - 1 && candidates.front() != last){
+            last = candidates.front();
+            fingerprints.push_back(runs[last]);
+        }
+    }
+
+    std::sort(fingerprints.begin(), fingerprints.end());
+}
@@ -0,0 +1,76 @@
+/** \class FingerprintIndex
+ * Finds the file pairs that may share a block by comparing fingerprints
+ * of the files instead of all their lines.
+ *
+ * Every run of k lines of a file is hashed with a rolling hash, and of
+ * every w consecutive run hashes the smallest is kept as a fingerprint
+ * (winnowing). Two files with a common block of at least k+w-1 lines
+ * share the fingerprint of every window inside that block, so file pairs
+ * without a common fingerprint need not be compared.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _FINGERPRINTINDEX_H_
+#define _FINGERPRINTINDEX_H_
+
+#include <vector>
+
+class SourceFile;
+
+class FingerprintIndex {
+protected:
+    // The distinct fingerprints of each file, as ids
+    std::vector<int> m_fileStart;
+    std::vector<int> m_fileIds;
+    // Files with the same fingerprint at two places
+    std::vector<char> m_selfRepeat;
+    // The files of each id, sorted
+    std::vector<int> m_bucketStart;
+    std::vector<int> m_files;
+    long long m_numFingerprints;
+
+public:
+    /**
+     * @param minBlockSize every block of at least this many lines is found
+     */
+    FingerprintIndex(const std::vector<SourceFile>& sourceFiles, unsigned int minBlockSize, int numThreads);
+
+    /**
+     * @brief Get the files that may share a block with file, the file
+     * itself included, sorted
+     *
+     * Only file and the files following it are returned. marked must
+     * have one entry per file, all 0, and is left that way.
+     */
+    void getCandidates(int file, std::vector<char>& marked, std::vector<int>& candidates) const;
+
+    long long getNumOfFingerprints() const;
+
+    /**
+     * @brief Choose the run length k and the window w so that every block
+     * of minBlockSize lines is found
+     */
+    static void GetParameters(unsigned int minBlockSize, int& k, int& w);
+
+    /**
+     * @brief Get the fingerprints of a file, sorted
+     *
+     * A fingerprint kept at two places of the file is listed twice.
+     */
+    static void Winnow(const SourceFile& sourceFile, int k, int w, std::vector<unsigned long long>& fingerprints);
+};
+
+#endif
@@ -0,0 +1,42 @@
+
+#include "GeneratorFactory.h"
+#include "TextGenerator.h"
+#include "XMLGenerator.h"
+#include "BinaryGenerator.h"
+#include "JsonGenerator.h"
+#include "SarifGenerator.h"
+
+bool GeneratorFactory::GetFormat( const std::string & name, FORMAT & format )
+{
+    if( name == "text" ) {
+        format = FORMAT_TEXT;
+    } else if( name == "xml" ) {
+        format = FORMAT_XML;
+    } else if( name == "binary" ) {
+        format = FORMAT_BINARY;
+    } else if( name == "json" ) {
+        format = FORMAT_JSON;
+    } else if( name == "sarif" ) {
+        format = FORMAT_SARIF;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::unique_ptr<IOutGenerator> GeneratorFactory::Create( FORMAT format, std::ostream & outfile, bool withText )
+{
+    switch( format )
+    {
+        case FORMAT_XML:
+            return std::make_unique<XMLGenerator>( outfile );
+        case FORMAT_BINARY:
+            return std::make_unique<BinaryGenerator>( outfile, withText );
+        case FORMAT_JSON:
+            return std::make_unique<JsonGenerator>( outfile );
+        case FORMAT_SARIF:
+            return std::make_unique<SarifGenerator>( outfile );
+        default:
+            return std::make_unique<TextGenerator>( outfile );
+    }
+}
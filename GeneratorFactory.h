@@ -0,0 +1,31 @@
+
+#if!defined __GENERATOR_FACTORY__
+#define __GENERATOR_FACTORY__
+
+#include "IOutGenerator.h"
+#include <iostream>
+#include <memory>
+#include <string>
+
+// Creates the report generator of an output format
+class GeneratorFactory
+{
+    public:
+    enum FORMAT
+    {
+        FORMAT_TEXT,
+        FORMAT_XML,
+        FORMAT_BINARY,
+        FORMAT_JSON,
+        FORMAT_SARIF
+    };
+
+    static bool GetFormat( const std::string & name, FORMAT & format );
+
+    // withText: keep the texts of the lines, only FORMAT_BINARY may leave them out
+    static std::unique_ptr<IOutGenerator> Create( FORMAT format, std::ostream & outfile, bool withText );
+};
+
+
+
+#endif
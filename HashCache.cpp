@@ -0,0 +1,218 @@
+/**
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "HashCache.h"
+
+#include "SourceFile.h"
+#include "BinaryIO.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sys/stat.h>
+
+namespace {
+    const char MAGIC[8] = { 'D', 'U', 'P', 'L', 'O', 'H', 'C', 0 };
+
+    // Bytes of a line in the cache: number, text length and hash
+    const unsigned long long LINE_SIZE = 2 * sizeof(int) + 2 * sizeof(long long);
+}
+
+HashCache::HashCache(const std::string& fileName, const std::string& settings) :
+    m_fileName(fileName),
+    m_settings(settings)
+{
+}
+
+bool HashCache::load(){
+    m_entries.clear();
+
+    std::ifstream in(m_fileName.c_str(), std::ios::in|std::ios::binary);
+    if(!in.is_open()){
+        return false;
+    }
+
+    return read(in);
+}
+
+bool HashCache::read(std::istream& in){
+    m_entries.clear();
+
+    // No count in the cache can be larger than the rest of it
+    const unsigned long long bytesLeft = BinaryIO::getBytesLeft(in);
+
+    char magic[sizeof(MAGIC)];
+    unsigned int version;
+    std::string settings;
+    unsigned int numEntries;
+    if(!in.read(magic, sizeof(magic)) || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+       !BinaryIO::readValue(in, version) || version != HASHCACHE_VERSION ||
+       !BinaryIO::readString(in, settings, bytesLeft) || settings != m_settings ||
+       !BinaryIO::readValue(in, numEntries)){
+        return false;
+    }
+
+    for(unsigned int i = 0; i < numEntries; i++){
+        std::string fileName;
+        Entry entry;
+        unsigned int numLines;
+        if(!BinaryIO::readString(in, fileName, bytesLeft) ||
+           !BinaryIO::readValue(in, entry.stamp.size) || !BinaryIO::readValue(in, entry.stamp.mtime) ||
+           !BinaryIO::readValue(in, entry.fileType) || !BinaryIO::readValue(in, entry.linesOfFile) ||
+           !BinaryIO::readValue(in, numLines) ||
+           (unsigned long long)numLines * LINE_SIZE > bytesLeft){
+            m_entries.clear();
+            return false;
+        }
+
+        entry.lineNumbers.resize(numLines);
+        entry.textLengths.resize(numLines);
+        entry.hashes.resize(2 * (size_t)numLines);
+        for(unsigned int j = 0; j < numLines; j++){
+            if(!BinaryIO::readValue(in, entry.lineNumbers[j]) || !BinaryIO::readValue(in, entry.textLengths[j]) ||
+               !BinaryIO::readValue(in, entry.hashes[2*j]) || !BinaryIO::readValue(in, entry.hashes[2*j+1])){
+                m_entries.clear();
+                return false;
+            }
+        }
+
+        m_entries[fileName] = std::move(entry);
+    }
+
+    return true;
+}
+
+bool HashCache::save() const {
+    // Write a new file and replace the old one with it, so an interrupted
+    // run does not leave a broken cache behind
+    const std::string tmpName = m_fileName + ".tmp";
+    {
+        std::ofstream out(tmpName.c_str(), std::ios::out|std::ios::binary);
+        if(!out.is_open() || !write(out)){
+            return false;
+        }
+    }
+
+    std::remove(m_fileName.c_str());
+    return std::rename(tmpName.c_str(), m_fileName.c_str()) == 0;
+}
+
+bool HashCache::write(std::ostream& out) const {
+    out.write(MAGIC, sizeof(MAGIC));
+    BinaryIO::writeValue<unsigned int>(out, HASHCACHE_VERSION);
+    BinaryIO::writeString(out, m_settings);
+    BinaryIO::writeValue<unsigned int>(out, (unsigned int)m_entries.size());
+
+    for(const auto& it : m_entries){
+        const Entry& entry = it.second;
+        BinaryIO::writeString(out, it.first);
+        BinaryIO::writeValue(out, entry.stamp.size);
+        BinaryIO::writeValue(out, entry.stamp.mtime);
+        BinaryIO::writeValue(out, entry.fileType);
+        BinaryIO::writeValue(out, entry.linesOfFile);
+        BinaryIO::writeValue<unsigned int>(out, (unsigned int)entry.lineNumbers.size());
+        for(size_t j = 0; j < entry.lineNumbers.size(); j++){
+            BinaryIO::writeValue(out, entry.lineNumbers[j]);
+            BinaryIO::writeValue(out, entry.textLengths[j]);
+            BinaryIO::writeValue(out, entry.hashes[2*j]);
+            BinaryIO::writeValue(out, entry.hashes[2*j+1]);
+        }
+    }
+
+    return (bool)out;
+}
+
+std::unique_ptr<SourceFile> HashCache::get(const std::string& fileName, const Stamp& stamp) const {
+    auto it = m_entries.find(fileName);
+    if(it == m_entries.end()){
+        return nullptr;
+    }
+
+    const Entry& entry = it->second;
+    if(entry.stamp.size != stamp.size || entry.stamp.mtime != stamp.mtime){
+        return nullptr;
+    }
+
+    return get(fileName);
+}
+
+std::unique_ptr<SourceFile> HashCache::get(const std::string& fileName) const {
+    auto it = m_entries.find(fileName);
+    if(it == m_entries.end()){
+        return nullptr;
+    }
+
+    const Entry& entry = it->second;
+    if(entry.fileType != FileType::GetFileType(fileName)){
+        return nullptr;
+    }
+
+    // The texts of the lines follow each other in the text of the file
+    std::vector<SourceLine> lines;
+    lines.reserve(entry.lineNumbers.size());
+    int textOffset = 0;
+    for(size_t j = 0; j < entry.lineNumbers.size(); j++){
+        lines.emplace_back(entry.lineNumbers[j], textOffset, entry.textLengths[j], entry.hashes[2*j], entry.hashes[2*j+1]);
+        textOffset += entry.textLengths[j];
+    }
+
+    return std::make_unique<SourceFile>(fileName, entry.linesOfFile, std::move(lines));
+}
+
+void HashCache::put(const SourceFile& sourceFile, const Stamp& stamp){
+    Entry entry;
+    entry.stamp = stamp;
+    entry.fileType = sourceFile.getFileType();
+    entry.linesOfFile = sourceFile.getNumOfLinesOfFile();
+
+    const int numLines = sourceFile.getNumOfLinesOfCode();
+    entry.lineNumbers.resize(numLines);
+    entry.textLengths.resize(numLines);
+    entry.hashes.resize(2 * (size_t)numLines);
+    for(int j = 0; j < numLines; j++){
+        const SourceLine& line = sourceFile.getLine(j);
+        entry.lineNumbers[j] = line.getLineNumber();
+        entry.textLengths[j] = line.getTextLength();
+        entry.hashes[2*j] = line.getHashHigh();
+        entry.hashes[2*j+1] = line.getHashLow();
+    }
+
+    m_entries[sourceFile.getFilename()] = std::move(entry);
+}
+
+void HashCache::clear(){
+    m_entries.clear();
+}
+
+int HashCache::getNumOfEntries() const {
+    return (int)m_entries.size();
+}
+
+bool HashCache::GetStamp(const std::string& fileName, Stamp& stamp){
+    struct stat st;
+    if(stat(fileName.c_str(), &st) != 0 || !S_ISREG(st.st_mode)){
+        return false;
+    }
+    stamp.size = (long long)st.st_size;
+#if defined(__linux__)
+    stamp.mtime = (long long)st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec;
+#elif defined(__APPLE__)
+    stamp.mtime = (long long)st.st_mtimespec.tv_sec * 1000000000LL + st.st_mtimespec.tv_nsec;
+#else
+    stamp.mtime = (long long)st.st_mtime;
+#endif
+    return true;
+}
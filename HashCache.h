@@ -0,0 +1,112 @@
+/** \class HashCache
+ * Keeps the line hashes of source files on disk between runs.
+ *
+ * For every file the cache stores its size and modification time along
+ * with the numbers and hashes of its lines of code. A file whose size
+ * and modification time did not change is created from the cache
+ * without reading or hashing it. The cache file starts with a version
+ * and the settings that affect which lines are kept and how they are
+ * hashed; a cache written by another version or with other settings is
+ * ignored.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _HASHCACHE_H_
+#define _HASHCACHE_H_
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class SourceFile;
+
+const unsigned int HASHCACHE_VERSION = 2;
+
+class HashCache {
+public:
+    /**
+     * Identifies the state of a file on disk
+     */
+    struct Stamp {
+        long long size;
+        long long mtime;
+    };
+
+protected:
+    struct Entry {
+        Stamp stamp;
+        int fileType;
+        int linesOfFile;
+        std::vector<int> lineNumbers;
+        std::vector<int> textLengths;
+        std::vector<long long> hashes;
+    };
+
+    std::string m_fileName;
+    std::string m_settings;
+    std::unordered_map<std::string, Entry> m_entries;
+
+public:
+    HashCache(const std::string& fileName, const std::string& settings);
+
+    /**
+     * @brief Read the cache file, a missing or outdated cache is left empty
+     */
+    bool load();
+    bool save() const;
+
+    /**
+     * @brief Read or write the cache from or to a stream, to embed it in
+     * another file
+     */
+    bool read(std::istream& in);
+    bool write(std::ostream& out) const;
+
+    /**
+     * @brief Create a source file from the cache
+     *
+     * @return the file, or nullptr if it is not cached or changed since
+     */
+    std::unique_ptr<SourceFile> get(const std::string& fileName, const Stamp& stamp) const;
+
+    /**
+     * @brief Create a source file from the cache, trusting that it did not
+     * change since
+     */
+    std::unique_ptr<SourceFile> get(const std::string& fileName) const;
+
+    /**
+     * @brief Store the lines of a source file in the state given by stamp
+     */
+    void put(const SourceFile& sourceFile, const Stamp& stamp);
+
+    /**
+     * @brief Drop all entries, for instance before putting the current files
+     */
+    void clear();
+
+    int getNumOfEntries() const;
+
+    /**
+     * @brief Get the size and time of a regular file, false for anything
+     * else, as the content of pipes changes without them
+     */
+    static bool GetStamp(const std::string& fileName, Stamp& stamp);
+};
+
+#endif
@@ -0,0 +1,106 @@
+/**
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "HashIndex.h"
+
+#include "SourceFile.h"
+
+#include <algorithm>
+
+namespace {
+    struct Entry {
+        long long hashHigh;
+        long long hashLow;
+        int file;
+        int line;
+
+        bool operator<(const Entry& other) const {
+            if(hashHigh != other.hashHigh){
+                return hashHigh < other.hashHigh;
+            }
+            if(hashLow != other.hashLow){
+                return hashLow < other.hashLow;
+            }
+            if(file != other.file){
+                return file < other.file;
+            }
+            return line < other.line;
+        }
+    };
+}
+
+HashIndex::HashIndex(const std::vector<SourceFile>& sourceFiles)
+{
+    m_fileOffsets.reserve(sourceFiles.size() + 1);
+    m_fileOffsets.push_back(0);
+    for(const auto& sf : sourceFiles){
+        m_fileOffsets.push_back(m_fileOffsets.back() + sf.getNumOfLinesOfCode());
+    }
+
+    std::vector<Entry> entries;
+    entries.reserve(m_fileOffsets.back());
+    for(int i = 0; i < (int)sourceFiles.size(); i++){
+        const SourceFile& sf = sourceFiles[i];
+        const long long* highs = sf.getHashHighs();
+        const long long* lows = sf.getHashLows();
+        for(int j = 0; j < sf.getNumOfLinesOfCode(); j++){
+            entries.push_back(Entry{ highs[j], lows[j], i, j });
+        }
+    }
+
+    std::sort(entries.begin(), entries.end());
+
+    // Number the distinct hashes and lay their occurrences out contiguously
+    m_lineIds.resize(entries.size());
+    m_occurrences.reserve(entries.size());
+    for(size_t k = 0; k < entries.size(); k++){
+        const Entry& e = entries[k];
+        if(k == 0 || e.hashHigh != entries[k-1].hashHigh || e.hashLow != entries[k-1].hashLow){
+            m_bucketStart.push_back((int)k);
+        }
+        m_lineIds[m_fileOffsets[e.file] + e.line] = (int)m_bucketStart.size() - 1;
+        m_occurrences.push_back(Occurrence{ e.file, e.line });
+    }
+    m_bucketStart.push_back((int)entries.size());
+}
+
+int HashIndex::getLineId(int file, int line) const
+{
+    return m_lineIds[m_fileOffsets[file] + line];
+}
+
+int HashIndex::getNumOfIds() const
+{
+    return (int)m_bucketStart.size() - 1;
+}
+
+const HashIndex::Occurrence* HashIndex::begin(int id) const
+{
+    return m_occurrences.data() + m_bucketStart[id];
+}
+
+const HashIndex::Occurrence* HashIndex::end(int id) const
+{
+    return m_occurrences.data() + m_bucketStart[id + 1];
+}
+
+const HashIndex::Occurrence* HashIndex::lowerBound(int id, int file) const
+{
+    return std::lower_bound(begin(id), end(id), file, [ ] (const Occurrence& o, int f) -> bool
+        {
+            return o.file < f;
+        });
+}
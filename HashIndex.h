@@ -0,0 +1,69 @@
+/** \class HashIndex
+ * Maps every distinct line hash of a set of files to all the places it
+ * occurs, so file pairs that share no line are never looked at.
+ *
+ * The index is stored in compressed form: each line of code gets the id
+ * of its hash, and the occurrences of each id are kept contiguous and
+ * sorted by file and line.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _HASHINDEX_H_
+#define _HASHINDEX_H_
+
+#include <vector>
+
+class SourceFile;
+
+class HashIndex {
+public:
+    struct Occurrence {
+        int file;
+        int line;
+    };
+
+protected:
+    std::vector<int> m_fileOffsets;
+    std::vector<int> m_lineIds;
+    std::vector<int> m_bucketStart;
+    std::vector<Occurrence> m_occurrences;
+
+public:
+    HashIndex(const std::vector<SourceFile>& sourceFiles);
+
+    /**
+     * @brief Get the id of the hash of a line, equal lines share the same id
+     */
+    int getLineId(int file, int line) const;
+
+    /**
+     * @brief Get the number of distinct line hashes
+     */
+    int getNumOfIds() const;
+
+    /**
+     * @brief Get all occurrences of a hash, sorted by file and line
+     */
+    const Occurrence* begin(int id) const;
+    const Occurrence* end(int id) const;
+
+    /**
+     * @brief Get the first occurrence of a hash in the given file or a later one
+     */
+    const Occurrence* lowerBound(int id, int file) const;
+};
+
+#endif
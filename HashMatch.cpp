@@ -0,0 +1,143 @@
+/**
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "HashMatch.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define DUPLO_HAVE_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace {
+    typedef void (*MatchRowFunction)(long long, long long, const long long*, const long long*, int, unsigned long long*);
+
+    void matchRowScalar(long long high, long long low, const long long* highs, const long long* lows, int n, unsigned long long* row){
+        for(int w = 0; w < (n + 63) / 64; w++){
+            const int end = (n - w * 64 < 64) ? n - w * 64 : 64;
+            unsigned long long bits = 0;
+            for(int k = 0; k < end; k++){
+                const int x = w * 64 + k;
+                bits |= (unsigned long long)(highs[x] == high && lows[x] == low) << k;
+            }
+            row[w] = bits;
+        }
+    }
+
+#ifdef DUPLO_HAVE_X86_KERNELS
+    void matchRowSse2(long long high, long long low, const long long* highs, const long long* lows, int n, unsigned long long* row){
+        const __m128i h = _mm_set1_epi64x(high);
+        const __m128i l = _mm_set1_epi64x(low);
+        for(int w = 0; w < (n + 63) / 64; w++){
+            const int end = (n - w * 64 < 64) ? n - w * 64 : 64;
+            unsigned long long bits = 0;
+            int k = 0;
+            for(; k + 2 <= end; k += 2){
+                const int x = w * 64 + k;
+                // SSE2 has no 64 bit compare, both 32 bit halves must match
+                __m128i eq = _mm_and_si128(_mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(highs + x)), h),
+                                           _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(lows + x)), l));
+                eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+                bits |= (unsigned long long)_mm_movemask_pd(_mm_castsi128_pd(eq)) << k;
+            }
+            for(; k < end; k++){
+                const int x = w * 64 + k;
+                bits |= (unsigned long long)(highs[x] == high && lows[x] == low) << k;
+            }
+            row[w] = bits;
+        }
+    }
+
+    __attribute__((target("avx2")))
+    void matchRowAvx2(long long high, long long low, const long long* highs, const long long* lows, int n, unsigned long long* row){
+        const __m256i h = _mm256_set1_epi64x(high);
+        const __m256i l = _mm256_set1_epi64x(low);
+        for(int w = 0; w < (n + 63) / 64; w++){
+            const int end = (n - w * 64 < 64) ? n - w * 64 : 64;
+            unsigned long long bits = 0;
+            int k = 0;
+            for(; k + 4 <= end; k += 4){
+                const int x = w * 64 + k;
+                const __m256i eq = _mm256_and_si256(_mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(highs + x)), h),
+                                                    _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(lows + x)), l));
+                bits |= (unsigned long long)_mm256_movemask_pd(_mm256_castsi256_pd(eq)) << k;
+            }
+            for(; k < end; k++){
+                const int x = w * 64 + k;
+                bits |= (unsigned long long)(highs[x] == high && lows[x] == low) << k;
+            }
+            row[w] = bits;
+        }
+    }
+#endif
+
+    MatchRowFunction getMatchRow(HashMatch::KERNEL kernel){
+        switch(kernel){
+#ifdef DUPLO_HAVE_X86_KERNELS
+            case HashMatch::KERNEL_AVX2:
+                return matchRowAvx2;
+            case HashMatch::KERNEL_SSE2:
+                return matchRowSse2;
+#endif
+            default:
+                return matchRowScalar;
+        }
+    }
+}
+
+void HashMatch::matchRow(long long high, long long low, const long long* highs, const long long* lows, int n, unsigned long long* row){
+    static const MatchRowFunction function = getMatchRow(GetKernel());
+    function(high, low, highs, lows, n, row);
+}
+
+void HashMatch::matchRowWith(KERNEL kernel, long long high, long long low, const long long* highs, const long long* lows, int n, unsigned long long* row){
+    getMatchRow(kernel)(high, low, highs, lows, n, row);
+}
+
+HashMatch::KERNEL HashMatch::GetKernel(){
+    if(IsSupported(KERNEL_AVX2)){
+        return KERNEL_AVX2;
+    }
+    if(IsSupported(KERNEL_SSE2)){
+        return KERNEL_SSE2;
+    }
+    return KERNEL_SCALAR;
+}
+
+bool HashMatch::IsSupported(KERNEL kernel){
+    switch(kernel){
+#ifdef DUPLO_HAVE_X86_KERNELS
+        case KERNEL_AVX2:
+            return __builtin_cpu_supports("avx2");
+        case KERNEL_SSE2:
+            return true;
+#endif
+        case KERNEL_SCALAR:
+            return true;
+        default:
+            return false;
+    }
+}
+
+const char* HashMatch::GetKernelName(KERNEL kernel){
+    switch(kernel){
+        case KERNEL_AVX2:
+            return "avx2";
+        case KERNEL_SSE2:
+            return "sse2";
+        default:
+            return "scalar";
+    }
+}
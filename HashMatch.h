@@ -0,0 +1,56 @@
+/** \class HashMatch
+ * Compares one line hash against a block of line hashes.
+ *
+ * The comparison is done with AVX2 or SSE2 when the processor supports
+ * it, and one hash at a time otherwise. The implementation is chosen
+ * once, when it is first used.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _HASHMATCH_H_
+#define _HASHMATCH_H_
+
+class HashMatch {
+public:
+    enum KERNEL
+    {
+        KERNEL_SCALAR,
+        KERNEL_SSE2,
+        KERNEL_AVX2
+    };
+
+    /**
+     * @brief Mark the hashes equal to (high, low) in a bit set
+     *
+     * Bit x of row is set if highs[x] == high and lows[x] == low. All
+     * (n+63)/64 words of row are written.
+     */
+    static void matchRow(long long high, long long low, const long long* highs, const long long* lows, int n, unsigned long long* row);
+
+    /**
+     * @brief matchRow with the given kernel, which has to be supported
+     */
+    static void matchRowWith(KERNEL kernel, long long high, long long low, const long long* highs, const long long* lows, int n, unsigned long long* row);
+
+    /**
+     * @brief The fastest kernel the processor supports, used by matchRow
+     */
+    static KERNEL GetKernel();
+    static bool IsSupported(KERNEL kernel);
+    static const char* GetKernelName(KERNEL kernel);
+};
+
+#endif
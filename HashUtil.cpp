@@ -1,216 +1,322 @@
-#include "HashUtil.h"
-
-unsigned char HashUtil::m_PADDING[64] = {
-    0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
-};
-
-/** 
- * MD5 initialization. Begins an MD5 operation, writing a new context.
- */
-void HashUtil::MD5Init(MD5_CTX *context){
-  context->count[0] = context->count[1] = 0;
-  // Load magic initialization constants.
-  context->state[0] = 0x67452301;
-  context->state[1] = 0xefcdab89;
-  context->state[2] = 0x98badcfe;
-  context->state[3] = 0x10325476;
-}
-
-/**
- * MD5 block update operation. Continues an MD5 message-digest
- * operation, processing another message block, and updating the
- * context.
- */
-void HashUtil::MD5Update(MD5_CTX *context, unsigned char *input, unsigned int inputLen){
-    unsigned int i, index, partLen;
-
-    // Compute number of bytes mod 64
-    index = (unsigned int)((context->count[0] >> 3) & 0x3F);
-
-    /* Update number of bits */
-    if((context->count[0] += ((unsigned int)inputLen << 3)) < ((unsigned int)inputLen << 3)){
-        context->count[1]++;
-    }
-  
-    context->count[1] += ((unsigned int)inputLen >> 29);
-
-    partLen = 64 - index;
-
-    // Transform as many times as possible.
-    if(inputLen >= partLen){
-        MD5_memcpy((unsigned char*)&context->buffer[index], (unsigned char*)input, partLen);
-        MD5Transform (context->state, context->buffer);
-
-        for(i = partLen; i + 63 < inputLen; i += 64){
-            MD5Transform (context->state, &input[i]);
-        }
-    
-        index = 0;
-    
-    } else {
-        i = 0;
-    }
-
-    // Buffer remaining input
-    MD5_memcpy((unsigned char*)&context->buffer[index], (unsigned char*)&input[i], inputLen-i);
-}
-
-/**
- * MD5 finalization. Ends an MD5 message-digest operation, writing the the message digest and zeroizing the context.
- */
-void HashUtil::MD5Final( std::array<unsigned char, 16> & digest, MD5_CTX *context){
-    std::array<unsigned char, 8> bits;
-    unsigned int index, padLen;
-
-    // Save number of bits
-    MD5_Encode<8>(bits, context->count);
-
-
-    // Pad out to 56 mod 64.
-    index = (unsigned int)((context->count[0] >> 3) & 0x3f);
-    padLen = (index < 56) ? (56 - index) : (120 - index);
-    MD5Update (context, m_PADDING, padLen);
-
-    // Append length (before padding)
-    MD5Update (context, bits.data( ), 8);
-      
-    // Store state in digest
-    MD5_Encode<16>(digest, context->state);
-
-    // Zeroize sensitive information.
-    MD5_memset ((unsigned char*)context, 0, sizeof (*context));
-}
-
-/**
- * MD5 basic transformation. Transforms state based on block.
- */
-void HashUtil::MD5Transform(unsigned int state[4], unsigned char block[64]){
-    unsigned int a = state[0], b = state[1], c = state[2], d = state[3], x[16];
-
-    MD5_Decode(x, block, 64);
-
-    /* Round 1 */
-    FF (a, b, c, d, x[ 0], S11, 0xd76aa478); /* 1 */
-    FF (d, a, b, c, x[ 1], S12, 0xe8c7b756); /* 2 */
-    FF (c, d, a, b, x[ 2], S13, 0x242070db); /* 3 */
-    FF (b, c, d, a, x[ 3], S14, 0xc1bdceee); /* 4 */
-    FF (a, b, c, d, x[ 4], S11, 0xf57c0faf); /* 5 */
-    FF (d, a, b, c, x[ 5], S12, 0x4787c62a); /* 6 */
-    FF (c, d, a, b, x[ 6], S13, 0xa8304613); /* 7 */
-    FF (b, c, d, a, x[ 7], S14, 0xfd469501); /* 8 */
-    FF (a, b, c, d, x[ 8], S11, 0x698098d8); /* 9 */
-    FF (d, a, b, c, x[ 9], S12, 0x8b44f7af); /* 10 */
-    FF (c, d, a, b, x[10], S13, 0xffff5bb1); /* 11 */
-    FF (b, c, d, a, x[11], S14, 0x895cd7be); /* 12 */
-    FF (a, b, c, d, x[12], S11, 0x6b901122); /* 13 */
-    FF (d, a, b, c, x[13], S12, 0xfd987193); /* 14 */
-    FF (c, d, a, b, x[14], S13, 0xa679438e); /* 15 */
-    FF (b, c, d, a, x[15], S14, 0x49b40821); /* 16 */
-
-    /* Round 2 */
-    GG (a, b, c, d, x[ 1], S21, 0xf61e2562); /* 17 */
-    GG (d, a, b, c, x[ 6], S22, 0xc040b340); /* 18 */
-    GG (c, d, a, b, x[11], S23, 0x265e5a51); /* 19 */
-    GG (b, c, d, a, x[ 0], S24, 0xe9b6c7aa); /* 20 */
-    GG (a, b, c, d, x[ 5], S21, 0xd62f105d); /* 21 */
-    GG (d, a, b, c, x[10], S22,  0x2441453); /* 22 */
-    GG (c, d, a, b, x[15], S23, 0xd8a1e681); /* 23 */
-    GG (b, c, d, a, x[ 4], S24, 0xe7d3fbc8); /* 24 */
-    GG (a, b, c, d, x[ 9], S21, 0x21e1cde6); /* 25 */
-    GG (d, a, b, c, x[14], S22, 0xc33707d6); /* 26 */
-    GG (c, d, a, b, x[ 3], S23, 0xf4d50d87); /* 27 */
-    GG (b, c, d, a, x[ 8], S24, 0x455a14ed); /* 28 */
-    GG (a, b, c, d, x[13], S21, 0xa9e3e905); /* 29 */
-    GG (d, a, b, c, x[ 2], S22, 0xfcefa3f8); /* 30 */
-    GG (c, d, a, b, x[ 7], S23, 0x676f02d9); /* 31 */
-    GG (b, c, d, a, x[12], S24, 0x8d2a4c8a); /* 32 */
-
-    /* Round 3 */
-    HH (a, b, c, d, x[ 5], S31, 0xfffa3942); /* 33 */
-    HH (d, a, b, c, x[ 8], S32, 0x8771f681); /* 34 */
-    HH (c, d, a, b, x[11], S33, 0x6d9d6122); /* 35 */
-    HH (b, c, d, a, x[14], S34, 0xfde5380c); /* 36 */
-    HH (a, b, c, d, x[ 1], S31, 0xa4beea44); /* 37 */
-    HH (d, a, b, c, x[ 4], S32, 0x4bdecfa9); /* 38 */
-    HH (c, d, a, b, x[ 7], S33, 0xf6bb4b60); /* 39 */
-    HH (b, c, d, a, x[10], S34, 0xbebfbc70); /* 40 */
-    HH (a, b, c, d, x[13], S31, 0x289b7ec6); /* 41 */
-    HH (d, a, b, c, x[ 0], S32, 0xeaa127fa); /* 42 */
-    HH (c, d, a, b, x[ 3], S33, 0xd4ef3085); /* 43 */
-    HH (b, c, d, a, x[ 6], S34,  0x4881d05); /* 44 */
-    HH (a, b, c, d, x[ 9], S31, 0xd9d4d039); /* 45 */
-    HH (d, a, b, c, x[12], S32, 0xe6db99e5); /* 46 */
-    HH (c, d, a, b, x[15], S33, 0x1fa27cf8); /* 47 */
-    HH (b, c, d, a, x[ 2], S34, 0xc4ac5665); /* 48 */
-
-    /* Round 4 */
-    II (a, b, c, d, x[ 0], S41, 0xf4292244); /* 49 */
-    II (d, a, b, c, x[ 7], S42, 0x432aff97); /* 50 */
-    II (c, d, a, b, x[14], S43, 0xab9423a7); /* 51 */
-    II (b, c, d, a, x[ 5], S44, 0xfc93a039); /* 52 */
-    II (a, b, c, d, x[12], S41, 0x655b59c3); /* 53 */
-    II (d, a, b, c, x[ 3], S42, 0x8f0ccc92); /* 54 */
-    II (c, d, a, b, x[10], S43, 0xffeff47d); /* 55 */
-    II (b, c, d, a, x[ 1], S44, 0x85845dd1); /* 56 */
-    II (a, b, c, d, x[ 8], S41, 0x6fa87e4f); /* 57 */
-    II (d, a, b, c, x[15], S42, 0xfe2ce6e0); /* 58 */
-    II (c, d, a, b, x[ 6], S43, 0xa3014314); /* 59 */
-    II (b, c, d, a, x[13], S44, 0x4e0811a1); /* 60 */
-    II (a, b, c, d, x[ 4], S41, 0xf7537e82); /* 61 */
-    II (d, a, b, c, x[11], S42, 0xbd3af235); /* 62 */
-    II (c, d, a, b, x[ 2], S43, 0x2ad7d2bb); /* 63 */
-    II (b, c, d, a, x[ 9], S44, 0xeb86d391); /* 64 */
-
-    state[0] += a;
-    state[1] += b;
-    state[2] += c;
-    state[3] += d;
-
-    // Zeroize sensitive information.
-    MD5_memset ((unsigned char*)x, 0, sizeof (x));
-}
-
-/**
- * Decodes input (unsigned char) into output (unsigned int). Assumes len is a multiple of 4.
- */
-void HashUtil::MD5_Decode(unsigned int *output, unsigned char *input, unsigned int len){
-    for(unsigned int i = 0, j = 0; j < len; i++, j += 4){
-        output[i] = ((unsigned int)input[j]) | (((unsigned int)input[j+1]) << 8) | (((unsigned int)input[j+2]) << 16) | (((unsigned int)input[j+3]) << 24);
-    }
-}
-
-/**
- * Note: Replace "for loop" with standard memcpy if possible.
- */
-void HashUtil::MD5_memcpy(unsigned char* output, unsigned char* input, unsigned int len){
-    for(unsigned int i = 0; i < len; i++){
-        output[i] = input[i];
-    }
-}
-
-/**
- * Note: Replace "for loop" with standard memset if possible.
- */
-void HashUtil::MD5_memset(unsigned char* output, int value, unsigned int len){
-    for(unsigned int i = 0; i < len; i++){
-        ((char *)output)[i] = (char)value;
-    }
-}
-
-
-void HashUtil::getMD5Sum(unsigned char* pData, int size, std::array<unsigned char, 16> & Digest ){
-    MD5_CTX context;
-    
-    MD5Init(&context);
-    MD5Update(&context, pData, size);
-    MD5Final(Digest, &context);
-
-    return;
-}
-
-
-
-
-
+#include "HashUtil.h"
+
+#include <cstring>
+
+unsigned char HashUtil::m_PADDING[64] = {
+    0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+/** 
+ * MD5 initialization. Begins an MD5 operation, writing a new context.
+ */
+void HashUtil::MD5Init(MD5_CTX *context){
+  context->count[0] = context->count[1] = 0;
+  // Load magic initialization constants.
+  context->state[0] = 0x67452301;
+  context->state[1] = 0xefcdab89;
+  context->state[2] = 0x98badcfe;
+  context->state[3] = 0x10325476;
+}
+
+/**
+ * MD5 block update operation. Continues an MD5 message-digest
+ * operation, processing another message block, and updating the
+ * context.
+ */
+void HashUtil::MD5Update(MD5_CTX *context, unsigned char *input, unsigned int inputLen){
+    unsigned int i, index, partLen;
+
+    // Compute number of bytes mod 64
+    index = (unsigned int)((context->count[0] >> 3) & 0x3F);
+
+    /* Update number of bits */
+    if((context->count[0] += ((unsigned int)inputLen << 3)) < ((unsigned int)inputLen << 3)){
+        context->count[1]++;
+    }
+  
+    context->count[1] += ((unsigned int)inputLen >> 29);
+
+    partLen = 64 - index;
+
+    // Transform as many times as possible.
+    if(inputLen >= partLen){
+        MD5_memcpy((unsigned char*)&context->buffer[index], (unsigned char*)input, partLen);
+        MD5Transform (context->state, context->buffer);
+
+        for(i = partLen; i + 63 < inputLen; i += 64){
+            MD5Transform (context->state, &input[i]);
+        }
+    
+        index = 0;
+    
+    } else {
+        i = 0;
+    }
+
+    // Buffer remaining input
+    MD5_memcpy((unsigned char*)&context->buffer[index], (unsigned char*)&input[i], inputLen-i);
+}
+
+/**
+ * MD5 finalization. Ends an MD5 message-digest operation, writing the the message digest and zeroizing the context.
+ */
+void HashUtil::MD5Final( std::array<unsigned char, 16> & digest, MD5_CTX *context){
+    std::array<unsigned char, 8> bits;
+    unsigned int index, padLen;
+
+    // Save number of bits
+    MD5_Encode<8>(bits, context->count);
+
+
+    // Pad out to 56 mod 64.
+    index = (unsigned int)((context->count[0] >> 3) & 0x3f);
+    padLen = (index < 56) ? (56 - index) : (120 - index);
+    MD5Update (context, m_PADDING, padLen);
+
+    // Append length (before padding)
+    MD5Update (context, bits.data( ), 8);
+      
+    // Store state in digest
+    MD5_Encode<16>(digest, context->state);
+
+    // Zeroize sensitive information.
+    MD5_memset ((unsigned char*)context, 0, sizeof (*context));
+}
+
+/**
+ * MD5 basic transformation. Transforms state based on block.
+ */
+void HashUtil::MD5Transform(unsigned int state[4], unsigned char block[64]){
+    unsigned int a = state[0], b = state[1], c = state[2], d = state[3], x[16];
+
+    MD5_Decode(x, block, 64);
+
+    /* Round 1 */
+    FF (a, b, c, d, x[ 0], S11, 0xd76aa478); /* 1 */
+    FF (d, a, b, c, x[ 1], S12, 0xe8c7b756); /* 2 */
+    FF (c, d, a, b, x[ 2], S13, 0x242070db); /* 3 */
+    FF (b, c, d, a, x[ 3], S14, 0xc1bdceee); /* 4 */
+    FF (a, b, c, d, x[ 4], S11, 0xf57c0faf); /* 5 */
+    FF (d, a, b, c, x[ 5], S12, 0x4787c62a); /* 6 */
+    FF (c, d, a, b, x[ 6], S13, 0xa8304613); /* 7 */
+    FF (b, c, d, a, x[ 7], S14, 0xfd469501); /* 8 */
+    FF (a, b, c, d, x[ 8], S11, 0x698098d8); /* 9 */
+    FF (d, a, b, c, x[ 9], S12, 0x8b44f7af); /* 10 */
+    FF (c, d, a, b, x[10], S13, 0xffff5bb1); /* 11 */
+    FF (b, c, d, a, x[11], S14, 0x895cd7be); /* 12 */
+    FF (a, b, c, d, x[12], S11, 0x6b901122); /* 13 */
+    FF (d, a, b, c, x[13], S12, 0xfd987193); /* 14 */
+    FF (c, d, a, b, x[14], S13, 0xa679438e); /* 15 */
+    FF (b, c, d, a, x[15], S14, 0x49b40821); /* 16 */
+
+    /* Round 2 */
+    GG (a, b, c, d, x[ 1], S21, 0xf61e2562); /* 17 */
+    GG (d, a, b, c, x[ 6], S22, 0xc040b340); /* 18 */
+    GG (c, d, a, b, x[11], S23, 0x265e5a51); /* 19 */
+    GG (b, c, d, a, x[ 0], S24, 0xe9b6c7aa); /* 20 */
+    GG (a, b, c, d, x[ 5], S21, 0xd62f105d); /* 21 */
+    GG (d, a, b, c, x[10], S22,  0x2441453); /* 22 */
+    GG (c, d, a, b, x[15], S23, 0xd8a1e681); /* 23 */
+    GG (b, c, d, a, x[ 4], S24, 0xe7d3fbc8); /* 24 */
+    GG (a, b, c, d, x[ 9], S21, 0x21e1cde6); /* 25 */
+    GG (d, a, b, c, x[14], S22, 0xc33707d6); /* 26 */
+    GG (c, d, a, b, x[ 3], S23, 0xf4d50d87); /* 27 */
+    GG (b, c, d, a, x[ 8], S24, 0x455a14ed); /* 28 */
+    GG (a, b, c, d, x[13], S21, 0xa9e3e905); /* 29 */
+    GG (d, a, b, c, x[ 2], S22, 0xfcefa3f8); /* 30 */
+    GG (c, d, a, b, x[ 7], S23, 0x676f02d9); /* 31 */
+    GG (b, c, d, a, x[12], S24, 0x8d2a4c8a); /* 32 */
+
+    /* Round 3 */
+    HH (a, b, c, d, x[ 5], S31, 0xfffa3942); /* 33 */
+    HH (d, a, b, c, x[ 8], S32, 0x8771f681); /* 34 */
+    HH (c, d, a, b, x[11], S33, 0x6d9d6122); /* 35 */
+    HH (b, c, d, a, x[14], S34, 0xfde5380c); /* 36 */
+    HH (a, b, c, d, x[ 1], S31, 0xa4beea44); /* 37 */
+    HH (d, a, b, c, x[ 4], S32, 0x4bdecfa9); /* 38 */
+    HH (c, d, a, b, x[ 7], S33, 0xf6bb4b60); /* 39 */
+    HH (b, c, d, a, x[10], S34, 0xbebfbc70); /* 40 */
+    HH (a, b, c, d, x[13], S31, 0x289b7ec6); /* 41 */
+    HH (d, a, b, c, x[ 0], S32, 0xeaa127fa); /* 42 */
+    HH (c, d, a, b, x[ 3], S33, 0xd4ef3085); /* 43 */
+    HH (b, c, d, a, x[ 6], S34,  0x4881d05); /* 44 */
+    HH (a, b, c, d, x[ 9], S31, 0xd9d4d039); /* 45 */
+    HH (d, a, b, c, x[12], S32, 0xe6db99e5); /* 46 */
+    HH (c, d, a, b, x[15], S33, 0x1fa27cf8); /* 47 */
+    HH (b, c, d, a, x[ 2], S34, 0xc4ac5665); /* 48 */
+
+    /* Round 4 */
+    II (a, b, c, d, x[ 0], S41, 0xf4292244); /* 49 */
+    II (d, a, b, c, x[ 7], S42, 0x432aff97); /* 50 */
+    II (c, d, a, b, x[14], S43, 0xab9423a7); /* 51 */
+    II (b, c, d, a, x[ 5], S44, 0xfc93a039); /* 52 */
+    II (a, b, c, d, x[12], S41, 0x655b59c3); /* 53 */
+    II (d, a, b, c, x[ 3], S42, 0x8f0ccc92); /* 54 */
+    II (c, d, a, b, x[10], S43, 0xffeff47d); /* 55 */
+    II (b, c, d, a, x[ 1], S44, 0x85845dd1); /* 56 */
+    II (a, b, c, d, x[ 8], S41, 0x6fa87e4f); /* 57 */
+    II (d, a, b, c, x[15], S42, 0xfe2ce6e0); /* 58 */
+    II (c, d, a, b, x[ 6], S43, 0xa3014314); /* 59 */
+    II (b, c, d, a, x[13], S44, 0x4e0811a1); /* 60 */
+    II (a, b, c, d, x[ 4], S41, 0xf7537e82); /* 61 */
+    II (d, a, b, c, x[11], S42, 0xbd3af235); /* 62 */
+    II (c, d, a, b, x[ 2], S43, 0x2ad7d2bb); /* 63 */
+    II (b, c, d, a, x[ 9], S44, 0xeb86d391); /* 64 */
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+
+    // Zeroize sensitive information.
+    MD5_memset ((unsigned char*)x, 0, sizeof (x));
+}
+
+/**
+ * Decodes input (unsigned char) into output (unsigned int). Assumes len is a multiple of 4.
+ */
+void HashUtil::MD5_Decode(unsigned int *output, unsigned char *input, unsigned int len){
+    for(unsigned int i = 0, j = 0; j < len; i++, j += 4){
+        output[i] = ((unsigned int)input[j]) | (((unsigned int)input[j+1]) << 8) | (((unsigned int)input[j+2]) << 16) | (((unsigned int)input[j+3]) << 24);
+    }
+}
+
+/**
+ * Note: Replace "for loop" with standard memcpy if possible.
+ */
+void HashUtil::MD5_memcpy(unsigned char* output, unsigned char* input, unsigned int len){
+    for(unsigned int i = 0; i < len; i++){
+        output[i] = input[i];
+    }
+}
+
+/**
+ * Note: Replace "for loop" with standard memset if possible.
+ */
+void HashUtil::MD5_memset(unsigned char* output, int value, unsigned int len){
+    for(unsigned int i = 0; i < len; i++){
+        ((char *)output)[i] = (char)value;
+    }
+}
+
+
+void HashUtil::getMD5Sum(unsigned char* pData, int size, std::array<unsigned char, 16> & Digest ){
+    MD5_CTX context;
+    
+    MD5Init(&context);
+    MD5Update(&context, pData, size);
+    MD5Final(Digest, &context);
+
+    return;
+}
+
+void HashUtil::getMurmur3Sum(const unsigned char* pData, int size, unsigned long long& high, unsigned long long& low){
+    const int nblocks = size / 16;
+
+    unsigned long long h1 = 0;
+    unsigned long long h2 = 0;
+
+    const unsigned long long c1 = 0x87c37b91114253d5ULL;
+    const unsigned long long c2 = 0x4cf5ad432745937fULL;
+
+    // Body, 16 bytes at a time
+    for(int i = 0; i < nblocks; i++){
+        unsigned long long k1;
+        unsigned long long k2;
+        memcpy(&k1, pData + i * 16, 8);
+        memcpy(&k2, pData + i * 16 + 8, 8);
+
+        k1 *= c1; k1 = ROTL64(k1, 31); k1 *= c2; h1 ^= k1;
+
+        h1 = ROTL64(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+
+        k2 *= c2; k2 = ROTL64(k2, 33); k2 *= c1; h2 ^= k2;
+
+        h2 = ROTL64(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+    }
+
+    // Tail, the remaining 0 to 15 bytes
+    const unsigned char* tail = pData + nblocks * 16;
+
+    unsigned long long k1 = 0;
+    unsigned long long k2 = 0;
+
+    switch(size & 15){
+        case 15: k2 ^= ((unsigned long long)tail[14]) << 48; // fall through
+        case 14: k2 ^= ((unsigned long long)tail[13]) << 40; // fall through
+        case 13: k2 ^= ((unsigned long long)tail[12]) << 32; // fall through
+        case 12: k2 ^= ((unsigned long long)tail[11]) << 24; // fall through
+        case 11: k2 ^= ((unsigned long long)tail[10]) << 16; // fall through
+        case 10: k2 ^= ((unsigned long long)tail[ 9]) << 8;  // fall through
+        case  9: k2 ^= ((unsigned long long)tail[ 8]) << 0;
+                 k2 *= c2; k2 = ROTL64(k2, 33); k2 *= c1; h2 ^= k2;
+                 // fall through
+        case  8: k1 ^= ((unsigned long long)tail[ 7]) << 56; // fall through
+        case  7: k1 ^= ((unsigned long long)tail[ 6]) << 48; // fall through
+        case  6: k1 ^= ((unsigned long long)tail[ 5]) << 40; // fall through
+        case  5: k1 ^= ((unsigned long long)tail[ 4]) << 32; // fall through
+        case  4: k1 ^= ((unsigned long long)tail[ 3]) << 24; // fall through
+        case  3: k1 ^= ((unsigned long long)tail[ 2]) << 16; // fall through
+        case  2: k1 ^= ((unsigned long long)tail[ 1]) << 8;  // fall through
+        case  1: k1 ^= ((unsigned long long)tail[ 0]) << 0;
+                 k1 *= c1; k1 = ROTL64(k1, 31); k1 *= c2; h1 ^= k1;
+    }
+
+    // Finalization
+    h1 ^= (unsigned long long)size;
+    h2 ^= (unsigned long long)size;
+
+    h1 += h2;
+    h2 += h1;
+
+    h1 = FMIX64(h1);
+    h2 = FMIX64(h2);
+
+    h1 += h2;
+    h2 += h1;
+
+    high = h2;
+    low = h1;
+}
+
+void HashUtil::getHash(HASH hash, const unsigned char* pData, int size, long long& high, long long& low){
+    switch(hash)
+    {
+        case HASH_MD5:
+            {
+            std::array< unsigned char, 16> Digest;
+            getMD5Sum((unsigned char*)pData, size, Digest);
+            memcpy(&high, Digest.data(), 8);
+            memcpy(&low, Digest.data() + 8, 8);
+            }
+            break;
+
+        case HASH_MURMUR3:
+            {
+            unsigned long long h;
+            unsigned long long l;
+            getMurmur3Sum(pData, size, h, l);
+            high = (long long)h;
+            low = (long long)l;
+            }
+            break;
+    }
+}
+
+bool HashUtil::GetHash(const std::string& name, HASH& hash){
+    if(name == "md5"){
+        hash = HASH_MD5;
+    } else if(name == "murmur3"){
+        hash = HASH_MURMUR3;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+
+
+
+
@@ -3,6 +3,8 @@
 #define __I_OUT_GENERATOR__
 
 #include <string>
+#include <utility>
+#include <vector>
 
 class SourceFile;
 
@@ -20,6 +22,10 @@ class IOutGenerator
 		   const SourceFile& pSource1, 
 		   const SourceFile& pSource2 ) = 0; 
 
+    // A block of count lines found at all of the (file, line) pairs
+    virtual void reportClass(int count, 
+                   const std::vector<std::pair<const SourceFile*, int>> & blocks ) = 0;
+
     virtual void writeSummary( int num_files, 
                        int blocks_total,
                        int locks_total,
@@ -0,0 +1,108 @@
+
+#include "JsonGenerator.h"
+#include "SourceFile.h"
+#include "StringUtil.h"
+#include <iostream>
+
+JsonGenerator::JsonGenerator( std::ostream & outfile ) :
+    outfile_( outfile )
+{
+}
+void JsonGenerator::writeHeader( unsigned int m_minBlockSize,
+				 unsigned int m_minChars,
+				 bool m_ignorePrepStuff,
+				 bool m_ignoreSameFilename,
+                                 const std::string & version )
+{
+    record_ = "{\"type\":\"header\",\"version\":";
+    addString( version );
+    record_ += ",\"minBlockSize\":" + std::to_string( m_minBlockSize ) +
+        ",\"minCharLine\":" + std::to_string( m_minChars ) +
+        ",\"ignorePrepro\":" + (m_ignorePrepStuff ? "true" : "false") +
+        ",\"ignoreSameFilename\":" + (m_ignoreSameFilename ? "true" : "false") + "}\n";
+    outfile_ << record_;
+}
+void JsonGenerator::reportSeq(int line1,
+			      int line2,
+			      int count,
+			      const SourceFile& pSource1,
+			      const SourceFile& pSource2 )
+{
+    beginSet( count );
+    addBlock( pSource1.getFilename(), pSource1.getLine(line1).getLineNumber() );
+    addBlock( pSource2.getFilename(), pSource2.getLine(line2).getLineNumber() );
+    for(int j = 0; j < count; j++){
+        addLine( pSource1.getLineText(j+line1) );
+    }
+    endSet( );
+}
+
+void JsonGenerator::reportClass(int count,
+                                const std::vector<std::pair<const SourceFile*, int>> & blocks )
+{
+    beginSet( count );
+    for(const auto& block : blocks){
+        addBlock( block.first->getFilename(), block.first->getLine(block.second).getLineNumber() );
+    }
+    for(int j = 0; j < count; j++){
+        addLine( blocks[0].first->getLineText(j+blocks[0].second) );
+    }
+    endSet( );
+}
+
+void JsonGenerator::beginSet( int count )
+{
+    record_ = "{\"type\":\"set\",\"lineCount\":" + std::to_string( count ) + ",\"blocks\":[";
+    inLines_ = false;
+    first_ = true;
+}
+
+void JsonGenerator::addBlock( const std::string & fileName, int lineNumber )
+{
+    record_ += first_ ? "{\"sourceFile\":" : ",{\"sourceFile\":";
+    addString( fileName );
+    record_ += ",\"startLineNumber\":" + std::to_string( lineNumber ) + "}";
+    first_ = false;
+}
+
+void JsonGenerator::addLine( const std::string & text )
+{
+    if( !inLines_ ) {
+        record_ += "],\"lines\":[";
+        inLines_ = true;
+    } else {
+        record_ += ',';
+    }
+    addString( text );
+}
+
+void JsonGenerator::endSet( )
+{
+    // Sets without text have no lines
+    record_ += "]}\n";
+    outfile_ << record_;
+}
+
+void JsonGenerator::addString( const std::string & str )
+{
+    StringUtil::escapeJson( str, escaped_ );
+    record_ += '"';
+    record_ += escaped_;
+    record_ += '"';
+}
+
+void JsonGenerator::writeSummary( int num_files,
+			          int blocks_total,
+			          int locks_total,
+			          int num_duplicate_lines,
+			          double duration)
+{
+    outfile_ << "{\"type\":\"summary\",\"numFiles\":" << num_files <<
+        ",\"duplicateBlocks\":" << blocks_total <<
+        ",\"totalLinesOfCode\":" << locks_total <<
+        ",\"duplicateLinesOfCode\":" << num_duplicate_lines <<
+        ",\"time\":" << duration << "}\n";
+
+    // The report is complete, only now it has to reach the file
+    outfile_.flush();
+}
@@ -0,0 +1,58 @@
+
+#if!defined __JSON_GENERATOR__
+#define __JSON_GENERATOR__
+
+#include "IOutGenerator.h"
+#include <iostream>
+#include <string>
+
+// Writes the report as JSON lines: a header, one object per set of
+// duplicate blocks and a summary, each on a line of its own and complete
+// in itself, so a reader can handle one line at a time
+class JsonGenerator : public IOutGenerator
+{
+    public:
+
+    JsonGenerator( std::ostream & outfile );
+    virtual void writeHeader( unsigned int m_minBlockSize,
+                      unsigned int m_minChars,
+		      bool m_ignorePrepStuff,
+                      bool m_ignoreSameFilename,
+                      const std::string & version) override;
+    virtual void reportSeq(int line1,
+		   int line2,
+		   int count,
+		   const SourceFile& pSource1,
+		   const SourceFile& pSource2 ) override;
+
+    virtual void reportClass(int count,
+                   const std::vector<std::pair<const SourceFile*, int>> & blocks ) override;
+
+    virtual void writeSummary( int num_files,
+                       int blocks_total,
+                       int locks_total,
+                       int num_duplicate_lines,
+                       double duration
+                       ) override;
+
+    // A set written piece by piece, for writers without the SourceFiles
+    // like duplo-report: beginSet, addBlock for each place, addLine for
+    // each line if the text is known, endSet
+    void beginSet( int count );
+    void addBlock( const std::string & fileName, int lineNumber );
+    void addLine( const std::string & text );
+    void endSet( );
+
+    private:
+    void addString( const std::string & str );
+
+    std::ostream & outfile_;
+    std::string record_;
+    std::string escaped_;
+    bool inLines_ = false;
+    bool first_ = true;
+};
+
+
+
+#endif
@@ -0,0 +1,176 @@
+/**
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "Duplo.h"
+#include "ArgumentParser.h"
+
+#include <algorithm>
+#include <iostream>
+
+int Clamp (int upper, int lower, int value)
+{
+    return std::max( lower, std::min( upper, value ) );
+}
+
+/**
+ * Main routine
+ *
+ * @param argc  number of arguments
+ * @param argv  arguments
+ */
+const int MIN_BLOCK_SIZE = 4;
+const int MIN_CHARS = 3;
+
+void DisplayHelp( );
+
+int main(int argc, const char* argv[]){
+    ArgumentParser ap(argc, argv);
+
+
+    Duplo::ENGINE engine;
+    if(!Duplo::GetEngine(ap.getStr("-engine", "sparse"), engine)){
+        std::cout << "Error: Unknown engine: " << ap.getStr("-engine") << std::endl;
+        DisplayHelp( );
+        return 1;
+    }
+
+    HashUtil::HASH hash;
+    if(!HashUtil::GetHash(ap.getStr("-hash", "murmur3"), hash)){
+        std::cout << "Error: Unknown hash function: " << ap.getStr("-hash") << std::endl;
+        DisplayHelp( );
+        return 1;
+    }
+
+    GeneratorFactory::FORMAT format;
+    if(!GeneratorFactory::GetFormat(ap.getStr("-format", ap.is("-binary") ? "binary" : ap.is("-xml") ? "xml" : "text"), format)){
+        std::cout << "Error: Unknown format: " << ap.getStr("-format") << std::endl;
+        DisplayHelp( );
+        return 1;
+    }
+
+    if(!ap.is("--help") && argc > 2){
+        Duplo duplo(
+            argv[argc-2], 
+            ap.getInt("-ml", MIN_BLOCK_SIZE), 
+            Clamp( 100, 0, ap.getInt("-pt", 100) ),
+            ap.getInt("-mc", MIN_CHARS), 
+            ap.is("-ip"), ap.is("-d"), ap.is("-xml")
+        );
+        duplo.setEngine(engine);
+        duplo.setNumOfThreads(ap.getInt("-j", 1));
+        duplo.setHashFunction(hash);
+        duplo.setCacheFile(ap.getStr("-cache"));
+        duplo.setBaseline(ap.getStr("-baseline"), ap.getStr("-changed"));
+        duplo.setSaveBaseline(ap.getStr("-save-baseline"));
+        duplo.setStopLines(ap.getInt("-sf", 0), ap.getInt("-topk", TOP_STOP_LINES));
+        duplo.setMaxMemory(ap.getInt("-maxmem", MAX_MEMORY));
+        duplo.setAsyncReport(ap.is("-async"));
+        duplo.setReportFormat(format, !ap.is("-notext"));
+        duplo.setNormalizeTokens(ap.is("-tn"));
+        duplo.setCloneClasses(ap.is("-classes"));
+        duplo.setStatsFile(ap.getStr("-stats", ""));
+        duplo.setScanRoot(ap.getStr("-r", ""), ap.getStr("-include", ""), ap.getStr("-exclude", ""));
+        duplo.run(argv[argc-1]);
+    } else {
+        DisplayHelp( );
+    }
+
+    return 0;
+}
+
+void DisplayHelp( )
+{
+    std::cout << "\nNAME\n";
+    std::cout << "       Duplo " << VERSION << " - duplicate source code block finder\n\n";
+
+    std::cout << "\nSYNOPSIS\n";
+    std::cout << "       duplo [OPTIONS] [INTPUT_FILELIST] [OUTPUT_FILE]\n";
+    std::cout << "       duplo [OPTIONS] -r DIRECTORY [OUTPUT_FILE]\n";
+
+    std::cout << "\nDESCRIPTION\n";
+    std::cout << "       Duplo is a tool to find duplicated code blocks in large\n";
+    std::cout << "       C/C++/Java/C#/VB.Net software systems.\n\n";
+
+    std::cout << "       -ml              minimal block size in lines (default is " << MIN_BLOCK_SIZE << ")\n";
+    std::cout << "       -pt              percentage of lines of duplication threshold to override -ml\n";
+    std::cout << "                        (default is 100%)\n";
+    std::cout << "                        useful for identifying whole file class duplication\n";
+    std::cout << "       -mc              minimal characters in line (default is " << MIN_CHARS << ")\n";
+    std::cout << "                        lines with less characters are ignored\n";
+    std::cout << "       -ip              ignore preprocessor directives\n";
+    std::cout << "       -tn              compare lines by their tokens, lines that only\n";
+    std::cout << "                        differ in identifiers and literals are equal\n";
+    std::cout << "       -sf N            lines found in more than N files can not start a\n";
+    std::cout << "                        block, but may be part of one (default is off)\n";
+    std::cout << "       -topk K          number of most frequent lines listed with -sf\n";
+    std::cout << "                        (default is " << TOP_STOP_LINES << ")\n";
+    std::cout << "       -d               ignore file pairs with same name\n";
+    std::cout << "       -classes         merge the blocks of all file pairs into classes\n";
+    std::cout << "                        and report each once with all its places\n";
+    std::cout << "       -xml             output file in XML\n";
+    std::cout << "       -binary          output file in a compact binary format, which\n";
+    std::cout << "                        duplo-report turns into text, XML or JSON\n";
+    std::cout << "       -notext          leave the line texts out of the binary output\n";
+    std::cout << "       -format NAME     format of the output file (default is text)\n";
+    std::cout << "                        text, xml, binary: as above\n";
+    std::cout << "                        json: JSON lines, one line per set of blocks\n";
+    std::cout << "                        sarif: SARIF 2.1.0, one line per result\n";
+    std::cout << "       -async           write the output file on a thread of its own\n";
+    std::cout << "       -stats FILE      write the time of each phase and counters of the\n";
+    std::cout << "                        work done to FILE as JSON\n";
+    std::cout << "       -j N             number of threads loading and comparing files\n";
+    std::cout << "                        (default is 1)\n";
+    std::cout << "       -engine NAME     engine used to compare the files (default is sparse)\n";
+    std::cout << "                        sparse: compare each file with each other file\n";
+    std::cout << "                        matrix: like sparse, but using a dense matrix\n";
+    std::cout << "                        index: only compare files that share lines\n";
+    std::cout << "                        suffix: find repeats in all files at once and\n";
+    std::cout << "                        report each with all its places\n";
+    std::cout << "                        winnow: only compare files that share a\n";
+    std::cout << "                        fingerprint\n";
+    std::cout << "                        rolling: like matrix, but keeping only one row\n";
+    std::cout << "       -maxmem MB       memory the matrix engine may use (default is " << MAX_MEMORY << ")\n";
+    std::cout << "                        larger files are compared in tiles\n";
+    std::cout << "       -hash NAME       function used to hash lines (default is murmur3)\n";
+    std::cout << "                        murmur3: 128 bit MurmurHash3, fast\n";
+    std::cout << "                        md5: MD5, slow\n";
+    std::cout << "       -cache FILE      keep line hashes in FILE, unchanged files are not\n";
+    std::cout << "                        read and hashed again\n";
+    std::cout << "       -baseline FILE   only compare file pairs with a changed file, take\n";
+    std::cout << "                        the other blocks from the baseline FILE, the\n";
+    std::cout << "                        index engine then compares pairs like sparse\n";
+    std::cout << "       -changed LIST    files changed since the baseline (default is the\n";
+    std::cout << "                        files whose size or time changed)\n";
+    std::cout << "       -save-baseline FILE\n";
+    std::cout << "                        write the files and blocks of this run to FILE\n";
+    std::cout << "       -r DIRECTORY     take the source files below DIRECTORY instead of\n";
+    std::cout << "                        a filelist, files are read while it is scanned\n";
+    std::cout << "       -include GLOBS   with -r only take files matching one of the\n";
+    std::cout << "                        comma separated GLOBS, e.g. \"*.cpp,*.h\", also\n";
+    std::cout << "                        files of a type duplo doesn't know\n";
+    std::cout << "       -exclude GLOBS   with -r skip files matching one of the GLOBS,\n";
+    std::cout << "                        e.g. \"moc_*.cpp,test/*\"\n";
+    std::cout << "       INTPUT_FILELIST  input filelist\n";
+    std::cout << "       OUTPUT_FILE      output file\n";
+
+    std::cout << "\nVERSION\n";
+    std::cout << "       " << VERSION << "\n";
+
+    std::cout << "\nAUTHORS\n";
+    std::cout << "       Christian M. Ammann (cammann@giants.ch)\n";    
+    std::cout << "       Trevor D'Arcy-Evans (tdarcyevans@hotmail.com)\n\n";    
+}
+
@@ -0,0 +1,146 @@
+/**
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "MappedFile.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define DUPLO_HAVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string& fileName) :
+    m_fileName(fileName),
+    m_data(nullptr),
+    m_size(0),
+    m_mapping(nullptr),
+    m_isOpen(false)
+{
+#ifdef DUPLO_HAVE_MMAP
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if(fd >= 0){
+        struct stat st;
+        if(fstat(fd, &st) != 0){
+            st.st_mode = 0;
+        }
+        if(S_ISREG(st.st_mode)){
+            m_isOpen = true;
+            m_size = (size_t)st.st_size;
+            if(m_size > 0){
+                void* mapping = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if(mapping != MAP_FAILED){
+                    m_mapping = mapping;
+                    m_data = (const char*)mapping;
+                } else {
+                    m_isOpen = false;
+                }
+            }
+        }
+        close(fd);
+        if(m_isOpen){
+            return;
+        }
+        if(S_ISDIR(st.st_mode)){
+            // A directory opens and reads as empty, it is no file to compare
+            reportError();
+            return;
+        }
+    }
+#endif
+
+    if(!readBuffered()){
+        reportError();
+    }
+}
+
+MappedFile::~MappedFile(){
+#ifdef DUPLO_HAVE_MMAP
+    if(m_mapping){
+        munmap(m_mapping, m_size);
+    }
+#endif
+}
+
+void MappedFile::reportError() const {
+    std::cout << "Error: Can't open file: " <<  m_fileName <<  ". File doesn't exist or access denied.\n";
+}
+
+bool MappedFile::readBuffered(){
+    m_size = 0;
+
+    std::ifstream inFile(m_fileName.c_str(), std::ios::in|std::ios::binary);
+    if(!inFile.is_open()){
+        return false;
+    }
+
+    // The size of pipes is not known up front, read until the end
+    const size_t CHUNK = 64 * 1024;
+    while(inFile){
+        m_buffer.resize(m_size + CHUNK);
+        inFile.read(m_buffer.data() + m_size, CHUNK);
+        m_size += (size_t)inFile.gcount();
+    }
+    m_buffer.resize(m_size);
+
+    m_data = m_buffer.data();
+    m_isOpen = true;
+    return true;
+}
+
+bool MappedFile::isOpen() const {
+    return m_isOpen;
+}
+
+const char* MappedFile::data() const {
+    return m_data;
+}
+
+size_t MappedFile::size() const {
+    return m_size;
+}
+
+void MappedFile::getLines(std::vector<LineView>& lines) const {
+    lines.clear();
+    if(!m_isOpen){
+        return;
+    }
+
+    splitLines(m_data, m_data + m_size, true, lines);
+}
+
+void MappedFile::splitLines(const char* begin, const char* end, bool joinFirstNewline, std::vector<LineView>& lines){
+    lines.clear();
+
+    // Like StringUtil::split, a '\n' at the very start of the file does not
+    // end a line but belongs to the first one
+    const char* from = (begin == end || !joinFirstNewline) ? begin : begin + 1;
+    while(true){
+        const char* newline = (from == end) ? nullptr : (const char*)memchr(from, '\n', end - from);
+        if(!newline){
+            lines.push_back(LineView{ begin, (int)(end - begin) });
+            return;
+        }
+        lines.push_back(LineView{ begin, (int)(newline - begin) });
+        begin = newline + 1;
+        from = begin;
+    }
+}
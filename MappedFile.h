@@ -0,0 +1,83 @@
+/** \class MappedFile
+ * Maps a file into memory and splits it into lines without copying it.
+ *
+ * Regular files are mapped read only where the system supports it. Pipes,
+ * devices and systems without mmap are read into a buffer instead. The
+ * lines returned are views into the mapping or the buffer and are only
+ * valid as long as the MappedFile lives. Directories are not opened.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _MAPPEDFILE_H_
+#define _MAPPEDFILE_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * A line of a mapped file, without its '\n'
+ */
+struct LineView {
+    const char* data;
+    int size;
+
+    char operator[](int i) const { return data[i]; }
+    std::string str() const { return std::string(data, size); }
+};
+
+class MappedFile {
+protected:
+    std::string m_fileName;
+    const char* m_data;
+    size_t m_size;
+    void* m_mapping;
+    std::vector<char> m_buffer;
+    bool m_isOpen;
+
+    bool readBuffered();
+    void reportError() const;
+
+public:
+    MappedFile(const std::string& fileName);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const;
+    const char* data() const;
+    size_t size() const;
+
+    /**
+     * @brief Split the file at each '\n', like TextFile::readLines without
+     * trimming
+     *
+     * A file with n '\n' has n+1 lines, a '\r' before the '\n' is kept. A
+     * '\n' that is the first character of the file is part of the first line.
+     */
+    void getLines(std::vector<LineView>& lines) const;
+
+    /**
+     * @brief Split the buffer [begin, end) at each '\n'
+     *
+     * With joinFirstNewline a '\n' that is the first character of the
+     * buffer is part of the first line, like in getLines.
+     */
+    static void splitLines(const char* begin, const char* end, bool joinFirstNewline, std::vector<LineView>& lines);
+};
+
+#endif
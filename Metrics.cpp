@@ -0,0 +1,156 @@
+/**
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "Metrics.h"
+
+#include <chrono>
+#include <ctime>
+#include <fstream>
+
+namespace {
+    const char* PHASE_NAMES[Metrics::NUM_PHASES] = {
+        "list", "load", "read", "strip", "hash", "stopLines", "compare", "report"
+    };
+
+    const char* COUNTER_NAMES[Metrics::NUM_COUNTERS] = {
+        "files", "bytesRead", "linesKept", "linesFiltered",
+        "pairsCompared", "pairsSkipped", "pairsPruned", "matrixCells", "blocks"
+    };
+
+    long long toNanos(double seconds){
+        return (long long)(seconds * 1e9);
+    }
+}
+
+bool Metrics::m_enabled = false;
+std::atomic<long long> Metrics::m_wall[NUM_PHASES];
+std::atomic<long long> Metrics::m_cpu[NUM_PHASES];
+std::atomic<long long> Metrics::m_counters[NUM_COUNTERS];
+
+Metrics::Timer::Timer(PHASE phase, bool processCpu) :
+    m_phase(phase),
+    m_processCpu(processCpu),
+    m_running(m_enabled),
+    m_wallStart(0),
+    m_cpuStart(0)
+{
+    if(m_running){
+        m_wallStart = GetWallTime();
+        m_cpuStart = GetCpuTime(m_processCpu);
+    }
+}
+
+Metrics::Timer::~Timer(){
+    stop();
+}
+
+void Metrics::Timer::stop(){
+    if(m_running){
+        addTime(m_phase, GetWallTime() - m_wallStart, GetCpuTime(m_processCpu) - m_cpuStart);
+        m_running = false;
+    }
+}
+
+void Metrics::Timer::next(PHASE phase){
+    if(m_enabled){
+        const double wall = GetWallTime();
+        const double cpu = GetCpuTime(m_processCpu);
+        if(m_running){
+            addTime(m_phase, wall - m_wallStart, cpu - m_cpuStart);
+        }
+        m_wallStart = wall;
+        m_cpuStart = cpu;
+        m_running = true;
+    }
+    m_phase = phase;
+}
+
+void Metrics::setEnabled(bool enabled){
+    m_enabled = enabled;
+}
+
+bool Metrics::isEnabled(){
+    return m_enabled;
+}
+
+void Metrics::add(COUNTER counter, long long value){
+    if(m_enabled){
+        m_counters[counter] += value;
+    }
+}
+
+void Metrics::addTime(PHASE phase, double wallSeconds, double cpuSeconds){
+    if(m_enabled){
+        m_wall[phase] += toNanos(wallSeconds);
+        m_cpu[phase] += toNanos(cpuSeconds);
+    }
+}
+
+long long Metrics::get(COUNTER counter){
+    return m_counters[counter];
+}
+
+double Metrics::getWall(PHASE phase){
+    return m_wall[phase] / 1e9;
+}
+
+double Metrics::getCpu(PHASE phase){
+    return m_cpu[phase] / 1e9;
+}
+
+double Metrics::GetWallTime(){
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+double Metrics::GetCpuTime(bool process){
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+    struct timespec ts;
+    if(clock_gettime(process ? CLOCK_PROCESS_CPUTIME_ID : CLOCK_THREAD_CPUTIME_ID, &ts) == 0){
+        return ts.tv_sec + ts.tv_nsec / 1e9;
+    }
+#endif
+    // Only the time of the whole process is known
+    return (double)clock() / CLOCKS_PER_SEC;
+}
+
+bool Metrics::save(const std::string& fileName, const std::string& version, int numThreads,
+                   double wallSeconds, double cpuSeconds){
+    std::ofstream out(fileName.c_str(), std::ios::out|std::ios::binary);
+    if(!out.is_open()){
+        return false;
+    }
+
+    out << "{\n";
+    out << "  \"version\": \"" << version << "\",\n";
+    out << "  \"threads\": " << numThreads << ",\n";
+    out << "  \"wall\": " << wallSeconds << ",\n";
+    out << "  \"cpu\": " << cpuSeconds << ",\n";
+    out << "  \"phases\": {\n";
+    for(int phase = 0; phase < NUM_PHASES; phase++){
+        out << "    \"" << PHASE_NAMES[phase] << "\": { \"wall\": " << getWall((PHASE)phase)
+            << ", \"cpu\": " << getCpu((PHASE)phase) << " }" << (phase + 1 < NUM_PHASES ? ",\n" : "\n");
+    }
+    out << "  },\n";
+    out << "  \"counters\": {\n";
+    for(int counter = 0; counter < NUM_COUNTERS; counter++){
+        out << "    \"" << COUNTER_NAMES[counter] << "\": " << get((COUNTER)counter)
+            << (counter + 1 < NUM_COUNTERS ? ",\n" : "\n");
+    }
+    out << "  }\n";
+    out << "}\n";
+
+    return (bool)out;
+}
@@ -0,0 +1,122 @@
+/** \class Metrics
+ * Times the phases of a run and counts the work done in them.
+ *
+ * Nothing is measured unless the metrics are enabled, then the timers
+ * and counters may be used from any thread. A Timer adds the wall time
+ * and the CPU time from its start to its end to its phase. The phases
+ * done per file (read, strip, hash) are summed over the files and thus
+ * over all threads loading them, the other phases are timed on the main
+ * thread. save() writes all of it as JSON, for -stats.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _METRICS_H_
+#define _METRICS_H_
+
+#include <atomic>
+#include <string>
+
+class Metrics {
+public:
+    enum PHASE {
+        PHASE_LIST,         // reading the file list
+        PHASE_LOAD,         // loading all files, wall time of the whole phase
+        PHASE_READ,         // per file: opening and mapping it
+        PHASE_STRIP,        // per file: removing comments, splitting lines
+        PHASE_HASH,         // per file: filtering and hashing lines
+        PHASE_STOP_LINES,   // finding the lines too common to start a block
+        PHASE_COMPARE,      // comparing the files, without the report
+        PHASE_REPORT,       // writing the report
+        NUM_PHASES
+    };
+
+    enum COUNTER {
+        COUNTER_FILES,
+        COUNTER_BYTES_READ,
+        COUNTER_LINES_KEPT,
+        COUNTER_LINES_FILTERED,
+        COUNTER_PAIRS_COMPARED,
+        COUNTER_PAIRS_SKIPPED,
+        COUNTER_PAIRS_PRUNED,
+        COUNTER_MATRIX_CELLS,
+        COUNTER_BLOCKS,
+        NUM_COUNTERS
+    };
+
+    /**
+     * Measures from its construction to stop() or its destruction.
+     *
+     * With the process CPU time the threads started by the phase are
+     * counted too, otherwise only the calling thread.
+     */
+    class Timer {
+    protected:
+        PHASE m_phase;
+        bool m_processCpu;
+        bool m_running;
+        double m_wallStart;
+        double m_cpuStart;
+
+    public:
+        Timer(PHASE phase, bool processCpu = false);
+        ~Timer();
+
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+
+        void stop();
+        /**
+         * @brief Stop and go on with the next phase
+         */
+        void next(PHASE phase);
+    };
+
+protected:
+    static bool m_enabled;
+    // Times in nanoseconds, so they can be added atomically
+    static std::atomic<long long> m_wall[NUM_PHASES];
+    static std::atomic<long long> m_cpu[NUM_PHASES];
+    static std::atomic<long long> m_counters[NUM_COUNTERS];
+
+public:
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    static void add(COUNTER counter, long long value);
+    static void addTime(PHASE phase, double wallSeconds, double cpuSeconds);
+    static long long get(COUNTER counter);
+    static double getWall(PHASE phase);
+    static double getCpu(PHASE phase);
+
+    /**
+     * @brief Seconds since some fixed point in time
+     */
+    static double GetWallTime();
+    /**
+     * @brief CPU seconds used by the process or the calling thread
+     */
+    static double GetCpuTime(bool process);
+
+    /**
+     * @brief Write the phases and counters as JSON
+     *
+     * wallSeconds and cpuSeconds are the totals of the run.
+     */
+    static bool save(const std::string& fileName, const std::string& version, int numThreads,
+                     double wallSeconds, double cpuSeconds);
+};
+
+#endif
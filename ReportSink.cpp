@@ -0,0 +1,114 @@
+/**
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "ReportSink.h"
+
+ReportSink::ReportSink(std::ostream& out, bool async) :
+    m_out(out),
+    m_buffer(REPORT_BUFFER_SIZE),
+    m_async(async),
+    m_writing(false),
+    m_stop(false)
+{
+    setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+    if(m_async){
+        m_writer = std::thread(&ReportSink::write, this);
+    }
+}
+
+ReportSink::~ReportSink(){
+    sync();
+
+    if(m_async){
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_changed.notify_all();
+        m_writer.join();
+    }
+}
+
+void ReportSink::handOver(){
+    const size_t size = pptr() - pbase();
+    if(size == 0){
+        return;
+    }
+
+    if(!m_async){
+        m_out.write(pbase(), size);
+        setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+        return;
+    }
+
+    // Queue the filled buffer and go on in a free one
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_changed.wait(lock, [ this ] { return m_queue.size() < REPORT_QUEUE_SIZE; });
+    m_buffer.resize(size);
+    m_queue.push_back(std::move(m_buffer));
+    if(m_free.empty()){
+        m_buffer = std::vector<char>(REPORT_BUFFER_SIZE);
+    } else {
+        m_buffer = std::move(m_free.back());
+        m_free.pop_back();
+        m_buffer.resize(REPORT_BUFFER_SIZE);
+    }
+    lock.unlock();
+    m_changed.notify_all();
+
+    setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+}
+
+void ReportSink::write(){
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for(;;){
+        m_changed.wait(lock, [ this ] { return m_stop || !m_queue.empty(); });
+        if(m_queue.empty()){
+            return;
+        }
+
+        std::vector<char> buffer = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_writing = true;
+        lock.unlock();
+
+        m_out.write(buffer.data(), buffer.size());
+
+        lock.lock();
+        m_free.push_back(std::move(buffer));
+        m_writing = false;
+        m_changed.notify_all();
+    }
+}
+
+ReportSink::int_type ReportSink::overflow(int_type c){
+    handOver();
+    if(!traits_type::eq_int_type(c, traits_type::eof())){
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+    return traits_type::not_eof(c);
+}
+
+int ReportSink::sync(){
+    handOver();
+    if(m_async){
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_changed.wait(lock, [ this ] { return m_queue.empty() && !m_writing; });
+    }
+    m_out.flush();
+    return m_out ? 0 : -1;
+}
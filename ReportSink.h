@@ -0,0 +1,74 @@
+/** \class ReportSink
+ * Buffers the report in large blocks before it reaches the output file.
+ *
+ * The generators write to an std::ostream on top of the sink. Every
+ * REPORT_BUFFER_SIZE bytes the buffer is written to the file, or, with a
+ * writer thread, handed to that thread while the generators go on in a
+ * fresh buffer. Flushing the stream writes out everything and waits for
+ * the writer, so it is only done once the report is complete.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _REPORTSINK_H_
+#define _REPORTSINK_H_
+
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+// Bytes collected before they are written to the file
+const size_t REPORT_BUFFER_SIZE = 1 << 20;
+
+// Full buffers the writer thread may fall behind by
+const size_t REPORT_QUEUE_SIZE = 4;
+
+class ReportSink : public std::streambuf {
+protected:
+    std::ostream& m_out;
+    std::vector<char> m_buffer;
+
+    // Shared with the writer thread
+    bool m_async;
+    std::thread m_writer;
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    std::deque<std::vector<char>> m_queue;
+    std::vector<std::vector<char>> m_free;
+    bool m_writing;
+    bool m_stop;
+
+    /**
+     * @brief Pass the bytes in the buffer on and start a new one
+     */
+    void handOver();
+    void write();
+
+    int_type overflow(int_type c) override;
+    int sync() override;
+
+public:
+    /**
+     * @param async write the file on a thread of its own
+     */
+    ReportSink(std::ostream& out, bool async);
+    ~ReportSink();
+};
+
+#endif
@@ -0,0 +1,135 @@
+
+#include "SarifGenerator.h"
+#include "SourceFile.h"
+#include "StringUtil.h"
+#include <cctype>
+#include <iostream>
+
+namespace {
+    const char* RULE_ID = "duplicate-code";
+
+    // A file name as a relative or absolute URI reference
+    std::string toUri( const std::string & fileName )
+    {
+        static const char HEX[] = "0123456789ABCDEF";
+
+        std::string uri;
+        for(char c : fileName){
+            if( c == '\\' ) {
+                uri += '/';
+            } else if( isalnum( (unsigned char)c ) || c == '/' || c == '.' || c == '-' || c == '_' || c == '~' || c == ':' ) {
+                uri += c;
+            } else {
+                uri += '%';
+                uri += HEX[(unsigned char)c >> 4];
+                uri += HEX[(unsigned char)c & 15];
+            }
+        }
+        return uri;
+    }
+}
+
+SarifGenerator::SarifGenerator( std::ostream & outfile ) :
+    outfile_( outfile ),
+    firstResult_( true )
+{
+}
+void SarifGenerator::writeHeader( unsigned int m_minBlockSize,
+				 unsigned int m_minChars,
+				 bool m_ignorePrepStuff,
+				 bool m_ignoreSameFilename,
+                                 const std::string & version )
+{
+    record_ = "{\"$schema\":\"https://json.schemastore.org/sarif-2.1.0.json\",\"version\":\"2.1.0\",\"runs\":[{\n";
+    record_ += "\"tool\":{\"driver\":{\"name\":\"duplo\",\"version\":";
+    addString( version );
+    record_ += ",\"rules\":[{\"id\":\"";
+    record_ += RULE_ID;
+    record_ += "\",\"shortDescription\":{\"text\":\"Duplicate block of code\"}}]}},\n";
+    record_ += "\"invocations\":[{\"executionSuccessful\":true,\"properties\":{\"minBlockSize\":" + std::to_string( m_minBlockSize ) +
+        ",\"minCharLine\":" + std::to_string( m_minChars ) +
+        ",\"ignorePrepro\":" + (m_ignorePrepStuff ? "true" : "false") +
+        ",\"ignoreSameFilename\":" + (m_ignoreSameFilename ? "true" : "false") + "}}],\n";
+    record_ += "\"results\":[";
+    outfile_ << record_;
+}
+void SarifGenerator::reportSeq(int line1,
+			      int line2,
+			      int count,
+			      const SourceFile& pSource1,
+			      const SourceFile& pSource2 )
+{
+    beginResult( count, pSource1, line1 );
+    addRelated( 1, count, pSource2, line2 );
+    endResult();
+}
+
+void SarifGenerator::reportClass(int count,
+                                 const std::vector<std::pair<const SourceFile*, int>> & blocks )
+{
+    beginResult( count, *blocks[0].first, blocks[0].second );
+    for(size_t k = 1; k < blocks.size(); k++){
+        addRelated( (int)k, count, *blocks[k].first, blocks[k].second );
+    }
+    endResult();
+}
+
+void SarifGenerator::beginResult( int count, const SourceFile& pSource, int line )
+{
+    record_ = firstResult_ ? "\n" : ",\n";
+    firstResult_ = false;
+
+    record_ += "{\"ruleId\":\"";
+    record_ += RULE_ID;
+    record_ += "\",\"level\":\"warning\",\"message\":{\"text\":\"Duplicate block of " + std::to_string( count ) + " lines of code\"},";
+    record_ += "\"locations\":[{";
+    addLocation( count, pSource, line );
+    record_ += "}],\"relatedLocations\":[";
+}
+
+void SarifGenerator::addRelated( int id, int count, const SourceFile& pSource, int line )
+{
+    record_ += ( id == 1 ) ? "{\"id\":" : ",{\"id\":";
+    record_ += std::to_string( id ) + ",";
+    addLocation( count, pSource, line );
+    record_ += "}";
+}
+
+void SarifGenerator::endResult()
+{
+    record_ += "]}";
+    outfile_ << record_;
+}
+
+void SarifGenerator::addLocation( int count, const SourceFile& pSource, int line )
+{
+    // SARIF counts lines from 1
+    record_ += "\"physicalLocation\":{\"artifactLocation\":{\"uri\":";
+    addString( toUri( pSource.getFilename() ) );
+    record_ += "},\"region\":{\"startLine\":" + std::to_string( pSource.getLine(line).getLineNumber() + 1 ) +
+        ",\"endLine\":" + std::to_string( pSource.getLine(line+count-1).getLineNumber() + 1 ) + "}}";
+}
+
+void SarifGenerator::addString( const std::string & str )
+{
+    StringUtil::escapeJson( str, escaped_ );
+    record_ += '"';
+    record_ += escaped_;
+    record_ += '"';
+}
+
+void SarifGenerator::writeSummary( int num_files,
+			          int blocks_total,
+			          int locks_total,
+			          int num_duplicate_lines,
+			          double duration)
+{
+    outfile_ << "\n],\n\"properties\":{\"numFiles\":" << num_files <<
+        ",\"duplicateBlocks\":" << blocks_total <<
+        ",\"totalLinesOfCode\":" << locks_total <<
+        ",\"duplicateLinesOfCode\":" << num_duplicate_lines <<
+        ",\"time\":" << duration << "}}]}\n";
+
+    // The report is complete, only now it has to reach the file
+    outfile_.flush();
+}
@@ -0,0 +1,52 @@
+
+#if!defined __SARIF_GENERATOR__
+#define __SARIF_GENERATOR__
+
+#include "IOutGenerator.h"
+#include <iostream>
+#include <string>
+
+// Writes the report as a SARIF 2.1.0 log with one result per set of
+// duplicate blocks. Every result is on a line of its own and complete in
+// itself, so a reader can handle one line at a time.
+class SarifGenerator : public IOutGenerator
+{
+    public:
+
+    SarifGenerator( std::ostream & outfile );
+    virtual void writeHeader( unsigned int m_minBlockSize,
+                      unsigned int m_minChars,
+		      bool m_ignorePrepStuff,
+                      bool m_ignoreSameFilename,
+                      const std::string & version) override;
+    virtual void reportSeq(int line1,
+		   int line2,
+		   int count,
+		   const SourceFile& pSource1,
+		   const SourceFile& pSource2 ) override;
+
+    virtual void reportClass(int count,
+                   const std::vector<std::pair<const SourceFile*, int>> & blocks ) override;
+
+    virtual void writeSummary( int num_files,
+                       int blocks_total,
+                       int locks_total,
+                       int num_duplicate_lines,
+                       double duration
+                       ) override;
+    private:
+    void beginResult( int count, const SourceFile& pSource, int line );
+    void addRelated( int id, int count, const SourceFile& pSource, int line );
+    void endResult();
+    void addLocation( int count, const SourceFile& pSource, int line );
+    void addString( const std::string & str );
+
+    std::ostream & outfile_;
+    bool firstResult_;
+    std::string record_;
+    std::string escaped_;
+};
+
+
+
+#endif
@@ -1,230 +1,379 @@
-/**
- * This program is free software; you can redistribute it and/or modify
- * it under the terms of the GNU General Public License as published by
- * the Free Software Foundation; either version 2 of the License, or
- * (at your option) any later version.
- * 
- * This program is distributed in the hope that it will be useful,
- * but WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
- * GNU General Public License for more details.
- * 
- * You should have received a copy of the GNU General Public License
- * along with this program; if not, write to the Free Software
- * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
- */
-
-#include "SourceFile.h"
-
-#include "TextFile.h"
-#include "StringUtil.h"
-
-#include <algorithm>
-#include <assert.h>
-
-
-unsigned int SourceFile::m_minChars = 3;
-bool SourceFile::m_ignorePrepStuff = false;
-
-SourceFile::SourceFile(const std::string& fileName ) :
-    m_fileName(fileName),
-    m_FileType(FileType::GetFileType(fileName))
-{
-	TextFile listOfFiles(m_fileName.c_str());
-
-    std::vector<std::string> lines;
-    listOfFiles.readLines(lines, false);
-
-    //Get lines that the file has.
-    m_linesOfFile = lines.size( );
-    m_sourceLines.reserve( m_linesOfFile );
-	
-    int openBlockComments = 0;
-    int index = 0;
-    for( auto & line : lines ){
-        
-        int lineSize = static_cast<int>(line.size() );
-        std::string tmp;
-        tmp.reserve( lineSize );
-
-        // Remove block comments
-        if (FileType::FILETYPE_C    == m_FileType ||
-            FileType::FILETYPE_CPP  == m_FileType ||
-            FileType::FILETYPE_CXX  == m_FileType ||
-            FileType::FILETYPE_H    == m_FileType ||
-            FileType::FILETYPE_HPP  == m_FileType ||
-            FileType::FILETYPE_JAVA == m_FileType ||
-            FileType::FILETYPE_CS   == m_FileType ||
-            FileType::FILETYPE_QML  == m_FileType){
-
-            for( int j=0 ; j< lineSize ; j++ ) {
-
-                if( j < ( lineSize - 1 ) && line.substr( j, 2 ) == "/*" ) {
-
-                    openBlockComments++;
-                }
-
-                if(openBlockComments <= 0) {
-
-                    tmp.push_back(line[j]);
-                }
-
-                if( j > 0 && j < ( lineSize ) && line.substr( j - 1, 2 ) == "*/" ) {
-
-                    openBlockComments--;
-                }
-            }
-        }
-        if (FileType::FILETYPE_VB == m_FileType) {
-
-            tmp = line;
-        }
-
-        AddToLines( tmp , index );
-
-        index++;
-	}
-}
-
-void SourceFile::AddToLines( const std::string & tmp ,int index )
-{
-    std::string cleaned;
-    getCleanLine(tmp, cleaned);
-    
-    if(isSourceLine(cleaned)){
-
-        //m_sourceLines.push_back(new SourceLine(cleaned, index));
-        m_sourceLines.emplace_back( cleaned, index );
-    }
-}
-
-void SourceFile::getCleanLine(const std::string& line, std::string& cleanedLine){
-    // Remove single line comments
-	int lineSize = (int)line.size();
-
-    cleanedLine.reserve( lineSize );
-
-    for( int i=0;i< lineSize; i++ ) {
-
-        switch (m_FileType)
-        {
-            case FileType::FILETYPE_C   :
-            case FileType::FILETYPE_CPP :
-            case FileType::FILETYPE_CXX :
-            case FileType::FILETYPE_H   :
-            case FileType::FILETYPE_HPP :
-            case FileType::FILETYPE_JAVA:
-            case FileType::FILETYPE_CS  :
-            case FileType::FILETYPE_QML :
-                if( ( i < lineSize -1 ) && line.substr( i, 2 ) == "//" ) {
-                //if(i < lineSize-1 && line[i] == '/' && line[i+1] == '/'){
-                    return;
-                }
-                break;
-
-            case FileType::FILETYPE_VB  :
-                if(i < lineSize-1 && line[i] == '\''){
-                    return;
-                }
-                break;
-            default:
-                break;
-        }
-        cleanedLine.push_back(line[i]);
-    }
-}
-
-bool SourceFile::isSourceLine(const std::string& line){
-    std::string tmp = StringUtil::trim(line);
-
-    // filter min size lines
-    if (tmp.size() < m_minChars)
-    {
-        return false;
-    }
-
-    std::transform(tmp.begin(), tmp.end(), tmp.begin(), tolower);
-
-    if(m_ignorePrepStuff){
-        switch (m_FileType)
-        {
-            case FileType::FILETYPE_C   :
-            case FileType::FILETYPE_CPP :
-            case FileType::FILETYPE_CXX :
-            case FileType::FILETYPE_H   :
-            case FileType::FILETYPE_HPP :
-            case FileType::FILETYPE_JAVA:
-            case FileType::FILETYPE_QML:
-                if(tmp[0] == '#')
-                {
-                    return false;
-                }
-                break;
-
-            case FileType::FILETYPE_CS  :
-                {
-                if(tmp[0] == '#')
-                {
-                    return false;
-                }
-                // look for other markers to avoid
-                const std::string PreProc_CS[] = { "using", "private", "protected", "public" };
-
-                for (int i=0; i<4; i++ ) {
-                 if (tmp.find(PreProc_CS[i].c_str(), 0, PreProc_CS[i].length())!=std::string::npos)
-                    return false;
-                  }
-               }
-               break;
-
-            case FileType::FILETYPE_VB  :
-                {
-                // look for preprocessor marker in start of string
-                const std::string PreProc_VB = "imports";
-
-                return std::string::npos == tmp.find(PreProc_VB.c_str(), 0, PreProc_VB.length());
-                }
-                break;
-            default:
-                break;
-        }
-    }
-
-    bool bRet = (tmp.size() >= m_minChars);
-
-    assert(bRet);
-    
-    return bRet && std::find_if(tmp.begin(), tmp.end(), isalpha)!=tmp.end();
-}
-
-int SourceFile::getNumOfLinesOfCode() const
-{
-
-	return static_cast<int>( m_sourceLines.size() );
-}
-
-const SourceLine& SourceFile::getLine(const int index) const
-{
-
-	return m_sourceLines[index];
-}
-
-const std::string& SourceFile::getFilename () const {
-
-	return m_fileName;
-}
-
-int SourceFile::getNumOfLinesOfFile( )
-{
-    return m_linesOfFile;
-}
-    
-void SourceFile::setMinChars( unsigned int a_min_chars )
-{
-    m_minChars = a_min_chars;
-}
-
-void SourceFile::setIgnorePreprocessor( bool a_ignore )
-{
-    m_ignorePrepStuff = a_ignore;
-}
+/**
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "SourceFile.h"
+
+#include "CommentStripper.h"
+#include "MappedFile.h"
+#include "Metrics.h"
+#include "Tokenizer.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+
+namespace {
+    // Whether word occurs in [begin, end), ignoring case
+    bool containsNoCase(const char* begin, const char* end, const char* word){
+        const int size = (int)strlen(word);
+        for(const char* p = begin; end - p >= size; p++){
+            int i = 0;
+            while(i < size && tolower((unsigned char)p[i]) == word[i]){
+                i++;
+            }
+            if(i == size){
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+unsigned int SourceFile::m_minChars = 3;
+bool SourceFile::m_ignorePrepStuff = false;
+bool SourceFile::m_normalizeTokens = false;
+
+SourceFile::SourceFile(const std::string& fileName ) :
+    m_fileName(fileName),
+    m_FileType(FileType::GetFileType(fileName))
+{
+    Metrics::Timer timer( Metrics::PHASE_READ );
+    MappedFile file( m_fileName );
+    Metrics::add( Metrics::COUNTER_BYTES_READ, file.size( ) );
+    timer.next( Metrics::PHASE_STRIP );
+
+    // The comments are stripped from the whole file at once, the lines
+    // point into the code left. Only these buffers are allocated, the
+    // code buffer is reused by all files read on this thread.
+    static thread_local std::string code;
+    std::vector<LineView> lines;
+    SplitLines( file, code, lines );
+
+    timer.next( Metrics::PHASE_HASH );
+
+    //Get lines that the file has.
+    m_linesOfFile = lines.size( );
+    m_hashHighs.reserve( m_linesOfFile );
+    m_hashLows.reserve( m_linesOfFile );
+    m_lineNumbers.reserve( m_linesOfFile );
+    m_textOffsets.reserve( m_linesOfFile );
+    m_textLengths.reserve( m_linesOfFile );
+    m_text.reserve( file.size( ) );
+
+    // Files of unknown type have no lines of code
+    if( FileType::FILETYPE_UNKNOWN != m_FileType ) {
+
+        std::string cleaned;
+        std::string tokens;
+        int index = 0;
+        for( auto & line : lines ){
+
+            AddToLines( line , index, cleaned, tokens );
+
+            index++;
+        }
+    }
+
+    m_text.shrink_to_fit( );
+    SortLinesByHash( );
+    BuildSketch( );
+
+    Metrics::add( Metrics::COUNTER_LINES_KEPT, m_hashHighs.size( ) );
+    Metrics::add( Metrics::COUNTER_LINES_FILTERED, m_linesOfFile - m_hashHighs.size( ) );
+}
+
+SourceFile::SourceFile(const std::string& fileName, int linesOfFile, std::vector<SourceLine>&& lines ) :
+    m_fileName(fileName),
+    m_FileType(FileType::GetFileType(fileName)),
+    m_hasText(false),
+    m_linesOfFile(linesOfFile)
+{
+    for( const auto & line : lines ) {
+        AddLine( line );
+    }
+    SortLinesByHash( );
+    BuildSketch( );
+}
+
+void SourceFile::SplitLines( const MappedFile & file, std::string & code, std::vector<LineView> & lines ) const
+{
+    if( file.isOpen( ) ) {
+        CommentStripper::strip( file.data( ), file.data( ) + file.size( ), m_FileType, code );
+        MappedFile::splitLines( code.data( ), code.data( ) + code.size( ),
+                                file.size( ) > 0 && file.data( )[0] == '\n', lines );
+    }
+}
+
+std::string SourceFile::ReadText( ) const
+{
+    // The lines of code are picked as when the file was hashed, only
+    // their text is kept
+    std::string text;
+    if( FileType::FILETYPE_UNKNOWN == m_FileType ) {
+        return text;
+    }
+
+    MappedFile file( m_fileName );
+    std::string code;
+    std::vector<LineView> lines;
+    SplitLines( file, code, lines );
+
+    std::string cleaned;
+    for( auto & line : lines ) {
+        cleaned.assign( line.data, line.size );
+        if( isSourceLine( cleaned ) ) {
+            text.append( cleaned );
+        }
+    }
+    return text;
+}
+
+void SourceFile::SortLinesByHash( )
+{
+    m_linesByHash.resize( m_hashHighs.size( ) );
+    for( int i = 0; i < (int)m_linesByHash.size( ); i++ ) {
+        m_linesByHash[i] = i;
+    }
+    std::stable_sort( m_linesByHash.begin( ), m_linesByHash.end( ), [ this ] ( int a, int b ) -> bool
+        {
+            return m_hashHighs[a] < m_hashHighs[b] || ( m_hashHighs[a] == m_hashHighs[b] && m_hashLows[a] < m_hashLows[b] );
+        });
+}
+
+void SourceFile::BuildSketch( )
+{
+    // Equal lines are adjacent in m_linesByHash, so the high halves come
+    // out sorted. Lines only equal in the high half fall together, which
+    // can only make files look more alike than they are.
+    m_sketchHashes.clear( );
+    m_sketchCounts.clear( );
+    for( int i : m_linesByHash ) {
+        if( m_sketchHashes.empty( ) || m_sketchHashes.back( ) != m_hashHighs[i] ) {
+            m_sketchHashes.push_back( m_hashHighs[i] );
+            m_sketchCounts.push_back( 0 );
+        }
+        m_sketchCounts.back( )++;
+    }
+    m_sketchHashes.shrink_to_fit( );
+    m_sketchCounts.shrink_to_fit( );
+}
+
+bool SourceFile::mayShareBlock( const SourceFile& other, unsigned int minLines ) const
+{
+    // Every line of a block has its hash in both files, so each file needs
+    // at least minLines lines whose hash the other one has too
+    unsigned int shared1 = 0;
+    unsigned int shared2 = 0;
+    size_t a = 0;
+    size_t b = 0;
+    while( a < m_sketchHashes.size( ) && b < other.m_sketchHashes.size( ) ) {
+        if( m_sketchHashes[a] < other.m_sketchHashes[b] ) {
+            a++;
+        } else if( other.m_sketchHashes[b] < m_sketchHashes[a] ) {
+            b++;
+        } else {
+            shared1 += m_sketchCounts[a++];
+            shared2 += other.m_sketchCounts[b++];
+            if( shared1 >= minLines && shared2 >= minLines ) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void SourceFile::AddToLines( const LineView & line ,int index, std::string & cleaned, std::string & tokens )
+{
+    cleaned.assign( line.data, line.size );
+    
+    if(isSourceLine(cleaned)){
+
+        //m_sourceLines.push_back(new SourceLine(cleaned, index));
+        if( m_normalizeTokens ) {
+            Tokenizer::normalize( cleaned.data( ), cleaned.data( ) + cleaned.size( ), m_FileType, tokens );
+            AddLine( SourceLine( cleaned, tokens, index, (int)m_text.size( ) ) );
+        } else {
+            AddLine( SourceLine( cleaned, index, (int)m_text.size( ) ) );
+        }
+        m_text.append( cleaned );
+    }
+}
+
+void SourceFile::AddLine( const SourceLine & line )
+{
+    m_hashHighs.push_back( line.getHashHigh( ) );
+    m_hashLows.push_back( line.getHashLow( ) );
+    m_lineNumbers.push_back( line.getLineNumber( ) );
+    m_textOffsets.push_back( line.getTextOffset( ) );
+    m_textLengths.push_back( line.getTextLength( ) );
+}
+
+bool SourceFile::isSourceLine(const std::string& line) const {
+    // Only the first word of the line is looked at
+    const char* begin = line.data();
+    const char* end = begin + line.size();
+    while(begin != end && isspace((unsigned char)*begin)){
+        begin++;
+    }
+    const char* wordEnd = begin;
+    while(wordEnd != end && !isspace((unsigned char)*wordEnd)){
+        wordEnd++;
+    }
+
+    // filter min size lines
+    if ((unsigned int)(wordEnd - begin) < m_minChars)
+    {
+        return false;
+    }
+
+    if(m_ignorePrepStuff){
+        switch (m_FileType)
+        {
+            case FileType::FILETYPE_C   :
+            case FileType::FILETYPE_CPP :
+            case FileType::FILETYPE_CXX :
+            case FileType::FILETYPE_H   :
+            case FileType::FILETYPE_HPP :
+            case FileType::FILETYPE_JAVA:
+            case FileType::FILETYPE_QML:
+                if(*begin == '#')
+                {
+                    return false;
+                }
+                break;
+
+            case FileType::FILETYPE_CS  :
+                {
+                if(*begin == '#')
+                {
+                    return false;
+                }
+                // look for other markers to avoid
+                const char* PreProc_CS[] = { "using", "private", "protected", "public" };
+
+                for (int i=0; i<4; i++ ) {
+                 if (containsNoCase(begin, wordEnd, PreProc_CS[i]))
+                    return false;
+                  }
+               }
+               break;
+
+            case FileType::FILETYPE_VB  :
+                // look for preprocessor marker in start of string
+                return !containsNoCase(begin, wordEnd, "imports");
+            default:
+                break;
+        }
+    }
+
+    return std::find_if(begin, wordEnd, [ ] ( char c ) { return isalpha((unsigned char)c) != 0; }) != wordEnd;
+}
+
+int SourceFile::getNumOfLinesOfCode() const
+{
+
+	return static_cast<int>( m_hashHighs.size() );
+}
+
+SourceLine SourceFile::getLine(const int index) const
+{
+
+	return SourceLine( m_lineNumbers[index], m_textOffsets[index], m_textLengths[index], m_hashHighs[index], m_hashLows[index] );
+}
+
+const long long* SourceFile::getHashHighs() const
+{
+	return m_hashHighs.data();
+}
+
+const long long* SourceFile::getHashLows() const
+{
+	return m_hashLows.data();
+}
+
+const int* SourceFile::getLineNumbers() const
+{
+	return m_lineNumbers.data();
+}
+
+const int* SourceFile::getTextOffsets() const
+{
+	return m_textOffsets.data();
+}
+
+void SourceFile::setStopLines(std::vector<char>&& stopLines)
+{
+    m_stopLines = std::move(stopLines);
+}
+
+const char* SourceFile::getStopLines() const
+{
+	return m_stopLines.empty() ? nullptr : m_stopLines.data();
+}
+
+std::string SourceFile::getLineText(const int index) const
+{
+    if( !m_hasText ) {
+
+        // Read the text of the lines again, without hashing them
+        m_text = ReadText( );
+        m_hasText = true;
+    }
+
+    if( m_textOffsets[index] + m_textLengths[index] > (int)m_text.size( ) ) {
+
+        // The file changed since it was hashed
+        return std::string( );
+    }
+
+	return m_text.substr( m_textOffsets[index], m_textLengths[index] );
+}
+
+const std::vector<int>& SourceFile::getLinesByHash() const
+{
+	return m_linesByHash;
+}
+
+const std::string& SourceFile::getFilename () const {
+
+	return m_fileName;
+}
+
+FileType::FILETYPE SourceFile::getFileType() const {
+
+	return m_FileType;
+}
+
+int SourceFile::getNumOfLinesOfFile( ) const
+{
+    return m_linesOfFile;
+}
+    
+void SourceFile::setMinChars( unsigned int a_min_chars )
+{
+    m_minChars = a_min_chars;
+}
+
+void SourceFile::setIgnorePreprocessor( bool a_ignore )
+{
+    m_ignorePrepStuff = a_ignore;
+}
+
+void SourceFile::setNormalizeTokens( bool a_normalize )
+{
+    m_normalizeTokens = a_normalize;
+}
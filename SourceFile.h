@@ -1,75 +1,148 @@
-/** \class SourceFile
- * Represents a source code file
- *
- * @author  Christian Ammann (cammann@giants.ch)
- * @date  16/05/05
- *
- * This program is free software; you can redistribute it and/or modify
- * it under the terms of the GNU General Public License as published by
- * the Free Software Foundation; either version 2 of the License, or
- * (at your option) any later version.
- * 
- * This program is distributed in the hope that it will be useful,
- * but WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
- * GNU General Public License for more details.
- * 
- * You should have received a copy of the GNU General Public License
- * along with this program; if not, write to the Free Software
- * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
- */
-
-#ifndef _SOURCEFILE_H_
-#define _SOURCEFILE_H_
-
-#include <string>
-#include <vector>
-
-#include "FileType.h"
-#include "SourceLine.h"
-
-//class SourceLine;
-
-class SourceFile {
-protected:
-    std::string m_fileName;
-    FileType::FILETYPE m_FileType;
-
-    static unsigned int m_minChars;
-    static bool m_ignorePrepStuff;
-
-    std::vector<SourceLine> m_sourceLines;
-
-    int m_linesOfFile = 0;
-
-	bool isSourceLine(const std::string& line);
-	void getCleanLine(const std::string& line, std::string& cleanedLine);
-
-public:
-    SourceFile(const std::string& fileName );
-    
-    /**
-     * @brief Get number of lines that are actual code
-     *
-     * @return number of lines of code
-     */
-    int getNumOfLinesOfCode() const;
-    /**
-     * @brief Get number of lines the file has
-     *
-     * @return number of lines the file has.
-     */
-    int getNumOfLinesOfFile( );
-    const SourceLine& getLine(const int index) const;
-    const std::string& getFilename() const;
-
-    static void setMinChars( unsigned int a_min_chars );
-    static void setIgnorePreprocessor( bool a_ignore );
-
-private:
-
-    void AddToLines( const std::string & tmp , int index );
-    void RemoveBlockComments( const std::string & line , int & openBlockComments );
-};
-
-#endif
+/** \class SourceFile
+ * Represents a source code file
+ *
+ * @author  Christian Ammann (cammann@giants.ch)
+ * @date  16/05/05
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _SOURCEFILE_H_
+#define _SOURCEFILE_H_
+
+#include <string>
+#include <vector>
+
+#include "FileType.h"
+#include "MappedFile.h"
+#include "SourceLine.h"
+
+//class SourceLine;
+
+class SourceFile {
+protected:
+    std::string m_fileName;
+    FileType::FILETYPE m_FileType;
+
+    static unsigned int m_minChars;
+    static bool m_ignorePrepStuff;
+    static bool m_normalizeTokens;
+
+    // The lines of code, one array per field so that the hashes can be
+    // compared many at a time
+    std::vector<long long> m_hashHighs;
+    std::vector<long long> m_hashLows;
+    std::vector<int> m_lineNumbers;
+    std::vector<int> m_textOffsets;
+    std::vector<int> m_textLengths;
+    std::vector<int> m_linesByHash;
+    // Sketch of the lines: the distinct high hash halves, sorted, and how
+    // many lines have each
+    std::vector<long long> m_sketchHashes;
+    std::vector<int> m_sketchCounts;
+    // Lines too common to start a block, empty if there are none
+    std::vector<char> m_stopLines;
+
+    // Text of all lines of code one after the other, for files created
+    // from their hashes it is read on demand
+    mutable std::string m_text;
+    mutable bool m_hasText = true;
+
+    int m_linesOfFile = 0;
+
+	bool isSourceLine(const std::string& line) const;
+
+public:
+    SourceFile(const std::string& fileName );
+    /**
+     * @brief Create a file from lines hashed earlier, without reading it
+     *
+     * The text of the lines is read from the file when it is first needed.
+     */
+    SourceFile(const std::string& fileName, int linesOfFile, std::vector<SourceLine>&& lines );
+    
+    /**
+     * @brief Get number of lines that are actual code
+     *
+     * @return number of lines of code
+     */
+    int getNumOfLinesOfCode() const;
+    /**
+     * @brief Get number of lines the file has
+     *
+     * @return number of lines the file has.
+     */
+    int getNumOfLinesOfFile( ) const;
+    SourceLine getLine(const int index) const;
+    /**
+     * @brief Get the hash halves of all lines of code, index by index
+     */
+    const long long* getHashHighs() const;
+    const long long* getHashLows() const;
+    const int* getLineNumbers() const;
+    const int* getTextOffsets() const;
+    /**
+     * @brief Mark the lines of code that may not start a block
+     */
+    void setStopLines(std::vector<char>&& stopLines);
+    /**
+     * @brief Get one flag per line of code, or nullptr if no line is a stop line
+     */
+    const char* getStopLines() const;
+    /**
+     * @brief Get the text of a line of code
+     */
+    std::string getLineText(const int index) const;
+    /**
+     * @brief Get the indices of the lines of code ordered by their hash
+     *
+     * Equal lines are adjacent and ordered by their index.
+     */
+    const std::vector<int>& getLinesByHash() const;
+    /**
+     * @brief Whether the files may share a block of minLines lines
+     *
+     * Compares the sketches of the files, false means they can't. Much
+     * cheaper than comparing the files, for pairs that are not alike.
+     */
+    bool mayShareBlock(const SourceFile& other, unsigned int minLines) const;
+    const std::string& getFilename() const;
+    FileType::FILETYPE getFileType() const;
+
+    static void setMinChars( unsigned int a_min_chars );
+    static void setIgnorePreprocessor( bool a_ignore );
+    /**
+     * @brief Hash lines by their tokens, so lines that only differ in
+     * identifiers and literals are equal
+     */
+    static void setNormalizeTokens( bool a_normalize );
+
+private:
+
+    void AddToLines( const LineView & line , int index, std::string & cleaned, std::string & tokens );
+    void AddLine( const SourceLine & line );
+    /**
+     * @brief Strip the comments of the file into code and split it into lines
+     */
+    void SplitLines( const MappedFile & file, std::string & code, std::vector<LineView> & lines ) const;
+    /**
+     * @brief Read the text of the lines of code, without hashing them
+     */
+    std::string ReadText( ) const;
+    void SortLinesByHash( );
+    void BuildSketch( );
+};
+
+#endif
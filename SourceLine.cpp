@@ -1,58 +1,94 @@
-/**
- * This program is free software; you can redistribute it and/or modify
- * it under the terms of the GNU General Public License as published by
- * the Free Software Foundation; either version 2 of the License, or
- * (at your option) any later version.
- * 
- * This program is distributed in the hope that it will be useful,
- * but WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
- * GNU General Public License for more details.
- * 
- * You should have received a copy of the GNU General Public License
- * along with this program; if not, write to the Free Software
- * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
- */
-
-#include "SourceLine.h"
-
-#include "HashUtil.h"
-
-/** 
- * Creates a new text file. The file is accessed relative to current directory.
- */
-SourceLine::SourceLine(std::string& line, int lineNumber){
-    m_line = line;
-    m_lineNumber = lineNumber;
-
-    std::string cleanLine;
-
-    //Remove all white space and noise (tabs etc)
-    for(int i=0;i<static_cast<int>( line.size() );i++){
-        if(line[i] > ' '){
-            cleanLine.push_back(line[i]);
-        }
-    }
-
-
-    // MD5 hash
-    std::array< unsigned char, 16> Digest;
-    HashUtil::getMD5Sum((unsigned char*)cleanLine.c_str(), (int)cleanLine.size(), Digest);
-    long long* pDigest = (long long *)Digest.data( );
-    m_hashHigh = pDigest[0];
-    m_hashLow = pDigest[1];
-}
-
-int SourceLine::getLineNumber() const{
-    return m_lineNumber;
-}
-
-bool SourceLine::equals( const SourceLine& pLine) const {
-
-    return (m_hashHigh == pLine.m_hashHigh && m_hashLow == pLine.m_hashLow);
-}
-
-const std::string& SourceLine::getLine() const {
-    return m_line;
-}
-
+/**
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "SourceLine.h"
+
+HashUtil::HASH SourceLine::m_hashFunction = HashUtil::HASH_MURMUR3;
+
+/** 
+ * Creates a new text file. The file is accessed relative to current directory.
+ */
+SourceLine::SourceLine(const std::string& line, int lineNumber, int textOffset) :
+    m_lineNumber(lineNumber),
+    m_textOffset(textOffset),
+    m_textLength((int)line.size())
+{
+
+    // Reused by all lines hashed on this thread
+    static thread_local std::string cleanLine;
+    cleanLine.clear();
+
+    //Remove all white space and noise (tabs etc)
+    for(int i=0;i<static_cast<int>( line.size() );i++){
+        if(line[i] > ' '){
+            cleanLine.push_back(line[i]);
+        }
+    }
+
+    HashUtil::getHash(m_hashFunction, (const unsigned char*)cleanLine.data(), (int)cleanLine.size(), m_hashHigh, m_hashLow);
+}
+
+SourceLine::SourceLine(const std::string& line, const std::string& tokens, int lineNumber, int textOffset) :
+    m_lineNumber(lineNumber),
+    m_textOffset(textOffset),
+    m_textLength((int)line.size())
+{
+    HashUtil::getHash(m_hashFunction, (const unsigned char*)tokens.data(), (int)tokens.size(), m_hashHigh, m_hashLow);
+}
+
+SourceLine::SourceLine(int lineNumber, int textOffset, int textLength, long long hashHigh, long long hashLow) :
+    m_hashHigh(hashHigh),
+    m_hashLow(hashLow),
+    m_lineNumber(lineNumber),
+    m_textOffset(textOffset),
+    m_textLength(textLength)
+{
+}
+
+void SourceLine::setHashFunction( HashUtil::HASH a_hash ){
+    m_hashFunction = a_hash;
+}
+
+int SourceLine::getLineNumber() const{
+    return m_lineNumber;
+}
+
+bool SourceLine::equals( const SourceLine& pLine) const {
+
+    return (m_hashHigh == pLine.m_hashHigh && m_hashLow == pLine.m_hashLow);
+}
+
+bool SourceLine::less( const SourceLine& pLine) const {
+
+    return (m_hashHigh < pLine.m_hashHigh || (m_hashHigh == pLine.m_hashHigh && m_hashLow < pLine.m_hashLow));
+}
+
+int SourceLine::getTextOffset() const {
+    return m_textOffset;
+}
+
+int SourceLine::getTextLength() const {
+    return m_textLength;
+}
+
+long long SourceLine::getHashHigh() const {
+    return m_hashHigh;
+}
+
+long long SourceLine::getHashLow() const {
+    return m_hashLow;
+}
+
@@ -1,45 +1,68 @@
-/** \class SourceLine
- * One line of source
- *
- * @author  Christian Ammann (cammann@giants.ch)
- * @date  16/05/05
- *
- * This program is free software; you can redistribute it and/or modify
- * it under the terms of the GNU General Public License as published by
- * the Free Software Foundation; either version 2 of the License, or
- * (at your option) any later version.
- * 
- * This program is distributed in the hope that it will be useful,
- * but WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
- * GNU General Public License for more details.
- * 
- * You should have received a copy of the GNU General Public License
- * along with this program; if not, write to the Free Software
- * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
- */
-
-#ifndef _SOURCELINE_H_
-#define _SOURCELINE_H_
-
-#include <string>
-#include <vector>
-
-class SourceLine {
-protected:
-    std::string m_line;
-    int m_lineNumber;
-    long long m_hashHigh;
-    long long m_hashLow;
-    
-public:
-    SourceLine(std::string& line, int lineNumber);
-    
-    
-    int getLineNumber() const;
-    const std::string& getLine() const;
-    bool equals( const SourceLine& pLine) const;
-};
-
-#endif
-
+/** \class SourceLine
+ * One line of source
+ *
+ * @author  Christian Ammann (cammann@giants.ch)
+ * @date  16/05/05
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _SOURCELINE_H_
+#define _SOURCELINE_H_
+
+#include <string>
+#include <vector>
+
+#include "HashUtil.h"
+
+class SourceLine {
+protected:
+    long long m_hashHigh;
+    long long m_hashLow;
+    int m_lineNumber;
+    // Position of the text of the line in the text of its SourceFile
+    int m_textOffset;
+    int m_textLength;
+
+    static HashUtil::HASH m_hashFunction;
+    
+public:
+    /**
+     * @brief Hash a line, its text is kept by the file at textOffset
+     */
+    SourceLine(const std::string& line, int lineNumber, int textOffset);
+    /**
+     * @brief Hash the tokens of a line as they are, see Tokenizer
+     */
+    SourceLine(const std::string& line, const std::string& tokens, int lineNumber, int textOffset);
+    /**
+     * @brief Create a line from a hash computed earlier
+     */
+    SourceLine(int lineNumber, int textOffset, int textLength, long long hashHigh, long long hashLow);
+    
+    
+    int getLineNumber() const;
+    int getTextOffset() const;
+    int getTextLength() const;
+    long long getHashHigh() const;
+    long long getHashLow() const;
+    bool equals( const SourceLine& pLine) const;
+    bool less( const SourceLine& pLine) const;
+
+    static void setHashFunction( HashUtil::HASH a_hash );
+};
+
+#endif
+
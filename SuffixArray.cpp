@@ -0,0 +1,221 @@
+/**
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "SuffixArray.h"
+
+#include <algorithm>
+
+namespace {
+    // Start (end == false) or end of the bucket of each character
+    void getBuckets(const int* text, int n, int alphabetSize, std::vector<int>& buckets, bool end){
+        buckets.assign(alphabetSize, 0);
+        for(int i = 0; i < n; i++){
+            buckets[text[i]]++;
+        }
+        int sum = 0;
+        for(int c = 0; c < alphabetSize; c++){
+            sum += buckets[c];
+            buckets[c] = end ? sum : sum - buckets[c];
+        }
+    }
+
+    void induceL(const int* text, int* sa, const std::vector<char>& isS, int n, int alphabetSize, std::vector<int>& buckets){
+        getBuckets(text, n, alphabetSize, buckets, false);
+        for(int i = 0; i < n; i++){
+            const int j = sa[i] - 1;
+            if(sa[i] > 0 && !isS[j]){
+                sa[buckets[text[j]]++] = j;
+            }
+        }
+    }
+
+    void induceS(const int* text, int* sa, const std::vector<char>& isS, int n, int alphabetSize, std::vector<int>& buckets){
+        getBuckets(text, n, alphabetSize, buckets, true);
+        for(int i = n - 1; i >= 0; i--){
+            const int j = sa[i] - 1;
+            if(sa[i] > 0 && isS[j]){
+                sa[--buckets[text[j]]] = j;
+            }
+        }
+    }
+
+    // SA-IS by Nong, Zhang and Chan
+    void sais(const int* text, int* sa, int n, int alphabetSize){
+        if(n == 1){
+            sa[0] = 0;
+            return;
+        }
+
+        // Classify the suffixes as S (smaller than the next) or L
+        std::vector<char> isS(n);
+        isS[n - 1] = 1;
+        for(int i = n - 2; i >= 0; i--){
+            isS[i] = text[i] < text[i + 1] || (text[i] == text[i + 1] && isS[i + 1]);
+        }
+        auto isLms = [ & ] ( int i ) -> bool
+            {
+                return i > 0 && isS[i] && !isS[i - 1];
+            };
+
+        // Sort the LMS substrings by inducing from their first characters
+        std::vector<int> buckets;
+        getBuckets(text, n, alphabetSize, buckets, true);
+        std::fill(sa, sa + n, -1);
+        for(int i = 1; i < n; i++){
+            if(isLms(i)){
+                sa[--buckets[text[i]]] = i;
+            }
+        }
+        induceL(text, sa, isS, n, alphabetSize, buckets);
+        induceS(text, sa, isS, n, alphabetSize, buckets);
+
+        int n1 = 0;
+        for(int i = 0; i < n; i++){
+            if(isLms(sa[i])){
+                sa[n1++] = sa[i];
+            }
+        }
+
+        // Name the LMS substrings, equal substrings get the same name
+        std::fill(sa + n1, sa + n, -1);
+        int name = 0;
+        int prev = -1;
+        for(int i = 0; i < n1; i++){
+            const int pos = sa[i];
+            bool diff = false;
+            for(int d = 0; d < n; d++){
+                if(prev == -1 || text[pos + d] != text[prev + d] || isS[pos + d] != isS[prev + d]){
+                    diff = true;
+                    break;
+                } else if(d > 0 && (isLms(pos + d) || isLms(prev + d))){
+                    break;
+                }
+            }
+            if(diff){
+                name++;
+                prev = pos;
+            }
+            sa[n1 + pos / 2] = name - 1;
+        }
+        for(int i = n - 1, j = n - 1; i >= n1; i--){
+            if(sa[i] >= 0){
+                sa[j--] = sa[i];
+            }
+        }
+
+        // Sort the LMS suffixes, recursing while names are not unique
+        int* reduced = sa + n - n1;
+        if(name < n1){
+            sais(reduced, sa, n1, name);
+        } else {
+            for(int i = 0; i < n1; i++){
+                sa[reduced[i]] = i;
+            }
+        }
+
+        // Induce the order of all suffixes from the sorted LMS suffixes
+        getBuckets(text, n, alphabetSize, buckets, true);
+        for(int i = 1, j = 0; i < n; i++){
+            if(isLms(i)){
+                reduced[j++] = i;
+            }
+        }
+        for(int i = 0; i < n1; i++){
+            sa[i] = reduced[sa[i]];
+        }
+        std::fill(sa + n1, sa + n, -1);
+        for(int i = n1 - 1; i >= 0; i--){
+            const int j = sa[i];
+            sa[i] = -1;
+            sa[--buckets[text[j]]] = j;
+        }
+        induceL(text, sa, isS, n, alphabetSize, buckets);
+        induceS(text, sa, isS, n, alphabetSize, buckets);
+    }
+}
+
+void SuffixArray::Build(const std::vector<int>& text, int alphabetSize, std::vector<int>& sa)
+{
+    sa.resize(text.size());
+    if(!text.empty()){
+        sais(text.data(), sa.data(), (int)text.size(), alphabetSize);
+    }
+}
+
+void SuffixArray::BuildLcp(const std::vector<int>& text, const std::vector<int>& sa, std::vector<int>& lcp)
+{
+    const int n = (int)text.size();
+    std::vector<int> rank(n);
+    for(int i = 0; i < n; i++){
+        rank[sa[i]] = i;
+    }
+
+    lcp.assign(n, 0);
+    int h = 0;
+    for(int i = 0; i < n; i++){
+        if(rank[i] > 0){
+            const int j = sa[rank[i] - 1];
+            while(i + h < n && j + h < n && text[i + h] == text[j + h]){
+                h++;
+            }
+            lcp[rank[i]] = h;
+            if(h > 0){
+                h--;
+            }
+        } else {
+            h = 0;
+        }
+    }
+}
+
+void SuffixArray::GetRepeats(const std::vector<int>& text, const std::vector<int>& sa, const std::vector<int>& lcp,
+                             int minLength, std::vector<Repeat>& repeats)
+{
+    const int n = (int)sa.size();
+
+    // The suffixes sa[begin, end) sharing a prefix of length are an
+    // interval, walked bottom up with a stack of the open intervals
+    struct Open {
+        int length;
+        int begin;
+    };
+    std::vector<Open> stack;
+    stack.push_back(Open{ 0, 0 });
+
+    for(int i = 1; i <= n; i++){
+        const int length = (i < n) ? lcp[i] : 0;
+        int begin = i - 1;
+        while(length < stack.back().length){
+            const Open open = stack.back();
+            stack.pop_back();
+            begin = open.begin;
+
+            if(open.length >= minLength){
+                // Skip the repeat if all occurrences follow the same character
+                bool leftMaximal = false;
+                for(int k = open.begin; k < i && !leftMaximal; k++){
+                    leftMaximal = (sa[k] == 0 || sa[open.begin] == 0 || text[sa[k] - 1] != text[sa[open.begin] - 1]);
+                }
+                if(leftMaximal){
+                    repeats.push_back(Repeat{ open.length, open.begin, i });
+                }
+            }
+        }
+        if(length > stack.back().length){
+            stack.push_back(Open{ length, begin });
+        }
+    }
+}
@@ -0,0 +1,60 @@
+/** \class SuffixArray
+ * Builds the suffix array and LCP array of an integer text and finds the
+ * maximal repeats in it.
+ *
+ * The suffix array is built with SA-IS in linear time, the LCP array with
+ * Kasai's algorithm. The text must end with a 0 that occurs nowhere else,
+ * and all other values must be in [1, alphabetSize).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _SUFFIXARRAY_H_
+#define _SUFFIXARRAY_H_
+
+#include <vector>
+
+class SuffixArray {
+public:
+    /**
+     * A run of length characters that starts at the suffixes
+     * sa[begin, end)
+     */
+    struct Repeat {
+        int length;
+        int begin;
+        int end;
+    };
+
+    static void Build(const std::vector<int>& text, int alphabetSize, std::vector<int>& sa);
+
+    /**
+     * @brief lcp[i] is the length of the common prefix of the suffixes
+     * sa[i-1] and sa[i], lcp[0] is 0
+     */
+    static void BuildLcp(const std::vector<int>& text, const std::vector<int>& sa, std::vector<int>& lcp);
+
+    /**
+     * @brief Find the repeats of at least minLength characters that can
+     * not be extended to the left or to the right
+     *
+     * Repeats that cover a shorter repeat with more occurrences are
+     * reported both, each with all of its occurrences.
+     */
+    static void GetRepeats(const std::vector<int>& text, const std::vector<int>& sa, const std::vector<int>& lcp,
+                           int minLength, std::vector<Repeat>& repeats);
+};
+
+#endif
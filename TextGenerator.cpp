@@ -1,9 +1,9 @@
 
 #include "SourceFile.h"
 #include "TextGenerator.h"
-#include <fstream>
+#include <iostream>
 
-TextGenerator::TextGenerator( std::ofstream & outfile ) :
+TextGenerator::TextGenerator( std::ostream & outfile ) :
    outfile_( outfile )
 {
 }
@@ -14,11 +14,11 @@ void TextGenerator::writeHeader( unsigned int m_minBlockSize,
 				 bool m_ignoreSameFilename,
                                  const std::string & version ) 
 {
-    outfile_ << "duplo version=\"" << version << "\"" << std::endl;
+    outfile_ << "duplo version=\"" << version << "\"\n";
     outfile_ << "    check Min_block_size=\"" << m_minBlockSize << 
         "\" Min_char_line=\"" << m_minChars << 
         "\" Ignore_prepro=\"" << (m_ignorePrepStuff ? "true" : "false") << 
-        "\" Ignore_same_filename=\"" << (m_ignoreSameFilename ? "true" : "false") << "\"" << std::endl << std::endl;
+        "\" Ignore_same_filename=\"" << (m_ignoreSameFilename ? "true" : "false") << "\"\n\n";
 }
 void TextGenerator::reportSeq(int line1, 
 			      int line2, 
@@ -26,12 +26,24 @@ void TextGenerator::reportSeq(int line1,
 			      const SourceFile& pSource1, 
 			      const SourceFile& pSource2 ) 
 {
-    outfile_ << pSource1.getFilename() << "(" << pSource1.getLine(line1).getLineNumber() << ")" << std::endl;
-    outfile_ << pSource2.getFilename() << "(" << pSource2.getLine(line2).getLineNumber() << ")" << std::endl;
+    outfile_ << pSource1.getFilename() << "(" << pSource1.getLine(line1).getLineNumber() << ")\n";
+    outfile_ << pSource2.getFilename() << "(" << pSource2.getLine(line2).getLineNumber() << ")\n";
     for(int j=0;j<count;j++){
-        outfile_ << pSource1.getLine(j+line1).getLine() << std::endl;
+        outfile_ << pSource1.getLineText(j+line1) << "\n";
     }
-    outfile_ << std::endl;
+    outfile_ << "\n";
+}
+
+void TextGenerator::reportClass(int count, 
+                                const std::vector<std::pair<const SourceFile*, int>> & blocks ) 
+{
+    for(const auto& block : blocks){
+        outfile_ << block.first->getFilename() << "(" << block.first->getLine(block.second).getLineNumber() << ")\n";
+    }
+    for(int j=0;j<count;j++){
+        outfile_ << blocks[0].first->getLineText(j+blocks[0].second) << "\n";
+    }
+    outfile_ << "\n";
 }
 
 void TextGenerator::writeSummary( int num_files, 
@@ -40,12 +52,15 @@ void TextGenerator::writeSummary( int num_files,
 			          int num_duplicate_lines, 
 			          double duration) 
 {
-    outfile_ << "Configuration: " << std::endl;
-    outfile_ << "  Number of files: " << num_files << std::endl;
-    outfile_ << std::endl;
-    outfile_ << "Results: " << std::endl;
-    outfile_ << "  Lines of code: " << locks_total << std::endl;
-    outfile_ << "  Duplicate lines of code: " << num_duplicate_lines << std::endl;
-    outfile_ << "  Total " << blocks_total << " duplicate block(s) found." << std::endl << std::endl;
-    outfile_ << "  Time: " << duration << " seconds" << std::endl;
+    outfile_ << "Configuration: \n";
+    outfile_ << "  Number of files: " << num_files << "\n";
+    outfile_ << "\n";
+    outfile_ << "Results: \n";
+    outfile_ << "  Lines of code: " << locks_total << "\n";
+    outfile_ << "  Duplicate lines of code: " << num_duplicate_lines << "\n";
+    outfile_ << "  Total " << blocks_total << " duplicate block(s) found.\n\n";
+    outfile_ << "  Time: " << duration << " seconds\n";
+
+    // The report is complete, only now it has to reach the file
+    outfile_.flush();
 }
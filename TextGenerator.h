@@ -9,7 +9,7 @@ class TextGenerator : public IOutGenerator
 {
     public:
 
-    TextGenerator( std::ofstream & outfile );
+    TextGenerator( std::ostream & outfile );
     virtual void writeHeader( unsigned int m_minBlockSize, 
                       unsigned int m_minChars,
 		      bool m_ignorePrepStuff, 
@@ -21,6 +21,9 @@ class TextGenerator : public IOutGenerator
 		   const SourceFile& pSource1, 
 		   const SourceFile& pSource2 ) override; 
 
+    virtual void reportClass(int count, 
+                   const std::vector<std::pair<const SourceFile*, int>> & blocks ) override;
+
     virtual void writeSummary( int num_files, 
                        int blocks_total,
                        int locks_total,
@@ -28,7 +31,7 @@ class TextGenerator : public IOutGenerator
                        double duration
                        ) override;
     private:
-    std::ofstream & outfile_;
+    std::ostream & outfile_;
 };
 
 
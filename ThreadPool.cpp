@@ -0,0 +1,150 @@
+/**
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "ThreadPool.h"
+
+namespace {
+    // Pool and index of the worker running on the current thread
+    thread_local const ThreadPool* t_pool = nullptr;
+    thread_local int t_worker = -1;
+}
+
+ThreadPool::ThreadPool(int numThreads) :
+    m_queued(0),
+    m_pending(0),
+    m_next(0),
+    m_stop(false)
+{
+    if(numThreads < 1){
+        numThreads = 1;
+    }
+
+    for(int i = 0; i < numThreads; i++){
+        m_workers.push_back(std::make_unique<Worker>());
+    }
+    for(int i = 0; i < numThreads; i++){
+        m_threads.emplace_back(&ThreadPool::work, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool(){
+    // Exceptions of tasks nobody waited for are dropped
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle.wait(lock, [this] { return m_pending == 0; });
+        m_stop = true;
+    }
+    m_wake.notify_all();
+
+    for(auto& thread : m_threads){
+        thread.join();
+    }
+}
+
+int ThreadPool::getNumOfThreads() const {
+    return (int)m_workers.size();
+}
+
+void ThreadPool::submit(Task task){
+    int worker = t_worker;
+    if(t_pool != this){
+        std::lock_guard<std::mutex> lock(m_mutex);
+        worker = m_next++ % m_workers.size();
+    }
+
+    m_pending++;
+    {
+        std::lock_guard<std::mutex> lock(m_workers[worker]->mutex);
+        m_workers[worker]->tasks.push_back(std::move(task));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queued++;
+    }
+    m_wake.notify_one();
+}
+
+void ThreadPool::wait(){
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_pending == 0; });
+    if(m_error){
+        std::exception_ptr error;
+        std::swap(error, m_error);
+        std::rethrow_exception(error);
+    }
+}
+
+bool ThreadPool::pop(int worker, Task& task){
+    // Own tasks first, in the order they were submitted
+    {
+        Worker& own = *m_workers[worker];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if(!own.tasks.empty()){
+            task = std::move(own.tasks.front());
+            own.tasks.pop_front();
+            return true;
+        }
+    }
+
+    // Then steal the most recently submitted task of another worker
+    for(size_t i = 1; i < m_workers.size(); i++){
+        Worker& other = *m_workers[(worker + i) % m_workers.size()];
+        std::lock_guard<std::mutex> lock(other.mutex);
+        if(!other.tasks.empty()){
+            task = std::move(other.tasks.back());
+            other.tasks.pop_back();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::work(int worker){
+    t_pool = this;
+    t_worker = worker;
+
+    for(;;){
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_queued > 0 || m_stop; });
+            if(m_queued == 0 && m_stop){
+                return;
+            }
+        }
+
+        Task task;
+        if(!pop(worker, task)){
+            continue;
+        }
+        m_queued--;
+
+        try {
+            task(worker);
+        } catch(...) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if(!m_error){
+                m_error = std::current_exception();
+            }
+        }
+
+        if(--m_pending == 0){
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_idle.notify_all();
+        }
+    }
+}
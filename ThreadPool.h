@@ -0,0 +1,88 @@
+/** \class ThreadPool
+ * Runs tasks on a fixed number of worker threads.
+ *
+ * Every worker owns a queue of tasks. Tasks submitted from outside the
+ * pool are dealt to the workers in turn, tasks submitted by a task go to
+ * the queue of the worker running it. A worker takes tasks from the front
+ * of its own queue and, once that is empty, steals from the back of the
+ * queues of the other workers, so a few expensive tasks do not leave the
+ * other workers idle.
+ *
+ * A task that throws does not stop the pool: the first exception is kept
+ * and thrown again by wait(), on the thread that waits.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _THREADPOOL_H_
+#define _THREADPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+    /**
+     * A task gets the index of the worker running it, which can be
+     * used to pick per worker scratch data.
+     */
+    typedef std::function<void(int worker)> Task;
+
+protected:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    std::atomic<int> m_queued;
+    std::atomic<int> m_pending;
+    unsigned int m_next;
+    bool m_stop;
+    // First exception thrown by a task since the last wait
+    std::exception_ptr m_error;
+
+    bool pop(int worker, Task& task);
+    void work(int worker);
+
+public:
+    ThreadPool(int numThreads);
+    ~ThreadPool();
+
+    int getNumOfThreads() const;
+
+    void submit(Task task);
+
+    /**
+     * @brief Block until all submitted tasks have run
+     *
+     * Throws the first exception a task threw, once all have run.
+     */
+    void wait();
+};
+
+#endif
@@ -0,0 +1,262 @@
+/**
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "Tokenizer.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace {
+    const char* KEYWORDS_C[] = {
+        "alignas", "alignof", "asm", "auto", "bool", "break", "case", "catch",
+        "char", "class", "const", "const_cast", "constexpr", "continue",
+        "decltype", "default", "delete", "do", "double", "dynamic_cast", "else",
+        "enum", "explicit", "extern", "false", "float", "for", "friend", "goto",
+        "if", "inline", "int", "long", "mutable", "namespace", "new", "noexcept",
+        "nullptr", "operator", "override", "private", "protected", "public",
+        "register", "reinterpret_cast", "return", "short", "signed", "sizeof",
+        "static", "static_assert", "static_cast", "struct", "switch", "template",
+        "this", "throw", "true", "try", "typedef", "typeid", "typename", "union",
+        "unsigned", "using", "virtual", "void", "volatile", "while"
+    };
+
+    const char* KEYWORDS_JAVA[] = {
+        "abstract", "assert", "boolean", "break", "byte", "case", "catch", "char",
+        "class", "const", "continue", "default", "do", "double", "else", "enum",
+        "extends", "false", "final", "finally", "float", "for", "goto", "if",
+        "implements", "import", "instanceof", "int", "interface", "long",
+        "native", "new", "null", "package", "private", "protected", "public",
+        "return", "short", "static", "strictfp", "super", "switch",
+        "synchronized", "this", "throw", "throws", "transient", "true", "try",
+        "void", "volatile", "while"
+    };
+
+    const char* KEYWORDS_CS[] = {
+        "abstract", "as", "base", "bool", "break", "byte", "case", "catch",
+        "char", "checked", "class", "const", "continue", "decimal", "default",
+        "delegate", "do", "double", "else", "enum", "event", "explicit",
+        "extern", "false", "finally", "fixed", "float", "for", "foreach", "goto",
+        "if", "implicit", "in", "int", "interface", "internal", "is", "lock",
+        "long", "namespace", "new", "null", "object", "operator", "out",
+        "override", "params", "private", "protected", "public", "readonly",
+        "ref", "return", "sbyte", "sealed", "short", "sizeof", "stackalloc",
+        "static", "string", "struct", "switch", "this", "throw", "true", "try",
+        "typeof", "uint", "ulong", "unchecked", "unsafe", "ushort", "using",
+        "var", "virtual", "void", "volatile", "while"
+    };
+
+    const char* KEYWORDS_VB[] = {
+        "addressof", "and", "andalso", "as", "boolean", "byref", "byte", "byval",
+        "call", "case", "catch", "class", "const", "dim", "do", "double", "each",
+        "else", "elseif", "end", "enum", "exit", "false", "finally", "for",
+        "friend", "function", "get", "handles", "if", "implements", "imports",
+        "in", "inherits", "integer", "interface", "is", "loop", "me", "mod",
+        "module", "mustinherit", "mustoverride", "mybase", "namespace", "new",
+        "next", "not", "nothing", "of", "or", "orelse", "overridable",
+        "overrides", "private", "property", "protected", "public", "readonly",
+        "return", "select", "set", "shared", "single", "string", "structure",
+        "sub", "then", "throw", "to", "true", "try", "until", "while", "with"
+    };
+
+    const char* KEYWORDS_QML[] = {
+        "alias", "break", "case", "catch", "const", "continue", "default",
+        "delete", "do", "else", "false", "finally", "for", "function", "if",
+        "import", "in", "instanceof", "let", "new", "null", "property",
+        "readonly", "return", "signal", "switch", "this", "throw", "true", "try",
+        "typeof", "undefined", "var", "void", "while"
+    };
+
+    // Longest keyword a case insensitive language may have
+    const int MAX_KEYWORD_LENGTH = 32;
+
+    bool lessKeyword(const char* a, const char* b){
+        return strcmp(a, b) < 0;
+    }
+
+    template <size_t N>
+    std::vector<const char*> sortedKeywords(const char* (&keywords)[N]){
+        std::vector<const char*> sorted(keywords, keywords + N);
+        std::sort(sorted.begin(), sorted.end(), lessKeyword);
+        return sorted;
+    }
+}
+
+const unsigned char* Tokenizer::GetClasses(){
+    struct Classes {
+        unsigned char table[256];
+
+        Classes(){
+            for(int c = 0; c < 256; c++){
+                if(c <= ' '){
+                    table[c] = CHAR_SPACE;
+                } else if(isalpha(c) || c == '_' || c == '$' || c >= 0x80){
+                    table[c] = CHAR_LETTER;
+                } else if(isdigit(c)){
+                    table[c] = CHAR_DIGIT;
+                } else if(c == '"' || c == '\''){
+                    table[c] = CHAR_QUOTE;
+                } else {
+                    table[c] = CHAR_OTHER;
+                }
+            }
+        }
+    };
+
+    static const Classes classes;
+    return classes.table;
+}
+
+const Tokenizer::Language& Tokenizer::GetLanguage(FileType::FILETYPE fileType){
+    static const Language c = { sortedKeywords(KEYWORDS_C), false, true, { '"', '\'' } };
+    static const Language java = { sortedKeywords(KEYWORDS_JAVA), false, true, { '"', '\'' } };
+    static const Language cs = { sortedKeywords(KEYWORDS_CS), false, true, { '"', '\'' } };
+    // VB has no escapes, "" inside a string is a quote and ' starts a comment
+    static const Language vb = { sortedKeywords(KEYWORDS_VB), true, false, { '"', '"' } };
+    static const Language qml = { sortedKeywords(KEYWORDS_QML), false, true, { '"', '\'' } };
+
+    switch(fileType){
+        case FileType::FILETYPE_JAVA:
+            return java;
+        case FileType::FILETYPE_CS:
+            return cs;
+        case FileType::FILETYPE_VB:
+            return vb;
+        case FileType::FILETYPE_QML:
+            return qml;
+        default:
+            return c;
+    }
+}
+
+bool Tokenizer::isKeyword(const Language& language, const char* begin, const char* end){
+    const int size = (int)(end - begin);
+    char lower[MAX_KEYWORD_LENGTH + 1];
+    if(language.ignoreCase){
+        if(size > MAX_KEYWORD_LENGTH){
+            return false;
+        }
+        for(int i = 0; i < size; i++){
+            lower[i] = (char)tolower((unsigned char)begin[i]);
+        }
+        lower[size] = 0;
+        begin = lower;
+    }
+
+    // Binary search without copying the word into a string
+    int low = 0;
+    int high = (int)language.keywords.size();
+    while(low < high){
+        const int mid = (low + high) / 2;
+        const char* keyword = language.keywords[mid];
+        int cmp = strncmp(keyword, begin, size);
+        if(cmp == 0 && keyword[size] != 0){
+            // The keyword is longer than the word
+            cmp = 1;
+        }
+        if(cmp == 0){
+            return true;
+        }
+        if(cmp < 0){
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return false;
+}
+
+const char* Tokenizer::skipNumber(const unsigned char* classes, const Language& language, const char* p, const char* end){
+    // 0x1F, 1.5e-3, 10'000 and 42UL are all one number
+    const char* begin = p;
+    while(p != end){
+        const char c = *p;
+        const unsigned char cls = classes[(unsigned char)c];
+        if(cls == CHAR_LETTER || cls == CHAR_DIGIT || c == '.' || (c == '\'' && !language.ignoreCase)){
+            p++;
+        } else if((c == '+' || c == '-') && p != begin && strchr("eEpP", p[-1]) != nullptr){
+            p++;
+        } else {
+            break;
+        }
+    }
+    return p;
+}
+
+void Tokenizer::normalize(const char* begin, const char* end, FileType::FILETYPE fileType, std::string& tokens){
+    const unsigned char* classes = GetClasses();
+    const Language& language = GetLanguage(fileType);
+
+    tokens.clear();
+    const char* p = begin;
+    while(p != end){
+        switch(classes[(unsigned char)*p]){
+            case CHAR_SPACE:
+                p++;
+                break;
+
+            case CHAR_LETTER: {
+                const char* word = p;
+                while(p != end && (classes[(unsigned char)*p] == CHAR_LETTER || classes[(unsigned char)*p] == CHAR_DIGIT)){
+                    p++;
+                }
+                if(isKeyword(language, word, p)){
+                    tokens.append(word, p);
+                } else {
+                    tokens.push_back(IDENTIFIER);
+                }
+                break;
+            }
+
+            case CHAR_DIGIT:
+                p = skipNumber(classes, language, p, end);
+                tokens.push_back(NUMBER);
+                break;
+
+            case CHAR_QUOTE: {
+                const char quote = *p;
+                if(quote != language.quotes[0] && quote != language.quotes[1]){
+                    tokens.push_back(*p++);
+                    break;
+                }
+                p++;
+                while(p != end){
+                    if(language.escapes && *p == '\\' && p + 1 != end){
+                        p += 2;
+                    } else if(*p++ == quote){
+                        if(language.escapes || p == end || *p != quote){
+                            break;
+                        }
+                        // A doubled quote inside the literal
+                        p++;
+                    }
+                }
+                tokens.push_back(LITERAL);
+                break;
+            }
+
+            default:
+                if(*p == '.' && p + 1 != end && classes[(unsigned char)p[1]] == CHAR_DIGIT){
+                    // .5 is a number, not a member access
+                    p = skipNumber(classes, language, p, end);
+                    tokens.push_back(NUMBER);
+                    break;
+                }
+                tokens.push_back(*p++);
+                break;
+        }
+    }
+}
@@ -0,0 +1,70 @@
+/** \class Tokenizer
+ * Tokenizer, turns a line of code into the tokens lines are hashed by
+ * when identifiers and literals do not matter.
+ *
+ * Every identifier becomes IDENTIFIER, every number NUMBER and every
+ * string or character literal LITERAL, so lines that only differ in
+ * names and values get the same tokens (type 2 clones). Keywords of the
+ * language of the file, operators and punctuation are kept as they are,
+ * whitespace is dropped. The line is scanned once, the class of every
+ * byte is looked up in a table and the tokens are written to a buffer
+ * the caller reuses.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _TOKENIZER_H_
+#define _TOKENIZER_H_
+
+#include <string>
+#include <vector>
+
+#include "FileType.h"
+
+class Tokenizer {
+public:
+    // Class tokens, bytes that do not occur in source code
+    static const char IDENTIFIER = '\x01';
+    static const char NUMBER = '\x02';
+    static const char LITERAL = '\x03';
+
+    /**
+     * @brief Write the tokens of the line [begin, end) to tokens
+     */
+    static void normalize(const char* begin, const char* end, FileType::FILETYPE fileType, std::string& tokens);
+
+private:
+    enum CHARCLASS {
+        CHAR_OTHER,
+        CHAR_SPACE,
+        CHAR_LETTER,
+        CHAR_DIGIT,
+        CHAR_QUOTE
+    };
+
+    struct Language {
+        std::vector<const char*> keywords;  // sorted
+        bool ignoreCase;                    // keywords are lower case then
+        bool escapes;                       // backslash escapes in literals
+        char quotes[2];                     // characters starting a literal
+    };
+
+    static const unsigned char* GetClasses();
+    static const Language& GetLanguage(FileType::FILETYPE fileType);
+    static bool isKeyword(const Language& language, const char* begin, const char* end);
+    static const char* skipNumber(const unsigned char* classes, const Language& language, const char* p, const char* end);
+};
+
+#endif
@@ -2,9 +2,9 @@
 #include "XMLGenerator.h"
 #include "SourceFile.h"
 #include "StringUtil.h"
-#include <fstream>
+#include <iostream>
 
-XMLGenerator::XMLGenerator( std::ofstream & outfile ) :
+XMLGenerator::XMLGenerator( std::ostream & outfile ) :
     outfile_( outfile )
 {
 }
@@ -14,13 +14,13 @@ void XMLGenerator::writeHeader( unsigned int m_minBlockSize,
 				 bool m_ignoreSameFilename,
                                  const std::string & version ) 
 {
-    outfile_ << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << std::endl;
-    outfile_ << "<?xml-stylesheet href=\"duplo.xsl\" type=\"text/xsl\"?>" << std::endl;
-    outfile_ << "<duplo version=\"" << version << "\">" << std::endl;
+    outfile_ << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    outfile_ << "<?xml-stylesheet href=\"duplo.xsl\" type=\"text/xsl\"?>\n";
+    outfile_ << "<duplo version=\"" << version << "\">\n";
     outfile_ << "    <check Min_block_size=\"" << m_minBlockSize << 
         "\" Min_char_line=\"" << m_minChars << 
         "\" Ignore_prepro=\"" << (m_ignorePrepStuff ? "true" : "false") << 
-        "\" Ignore_same_filename=\"" << (m_ignoreSameFilename ? "true" : "false") << "\">" << std::endl;
+        "\" Ignore_same_filename=\"" << (m_ignoreSameFilename ? "true" : "false") << "\">\n";
 }
 void XMLGenerator::reportSeq(int line1, 
 			      int line2, 
@@ -28,31 +28,35 @@ void XMLGenerator::reportSeq(int line1,
 			      const SourceFile& pSource1, 
 			      const SourceFile& pSource2 ) 
 {
-    outfile_ << "    <set LineCount=\"" << count << "\">" << std::endl;
-    outfile_ << "        <block SourceFile=\"" << pSource1.getFilename() << "\" StartLineNumber=\"" << pSource1.getLine(line1).getLineNumber() << "\"/>" << std::endl;
-    outfile_ << "        <block SourceFile=\"" << pSource2.getFilename() << "\" StartLineNumber=\"" << pSource2.getLine(line2).getLineNumber() << "\"/>" << std::endl;
-    outfile_ << "        <lines xml:space=\"preserve\">" << std::endl;
+    outfile_ << "    <set LineCount=\"" << count << "\">\n";
+    outfile_ << "        <block SourceFile=\"" << pSource1.getFilename() << "\" StartLineNumber=\"" << pSource1.getLine(line1).getLineNumber() << "\"/>\n";
+    outfile_ << "        <block SourceFile=\"" << pSource2.getFilename() << "\" StartLineNumber=\"" << pSource2.getLine(line2).getLineNumber() << "\"/>\n";
+    writeLines( pSource1, line1, count );
+    outfile_ << "    </set>\n";
+}
+
+void XMLGenerator::reportClass(int count, 
+                               const std::vector<std::pair<const SourceFile*, int>> & blocks ) 
+{
+    outfile_ << "    <set LineCount=\"" << count << "\">\n";
+    for(const auto& block : blocks){
+        outfile_ << "        <block SourceFile=\"" << block.first->getFilename() << "\" StartLineNumber=\"" << block.first->getLine(block.second).getLineNumber() << "\"/>\n";
+    }
+    writeLines( *blocks[0].first, blocks[0].second, count );
+    outfile_ << "    </set>\n";
+}
+
+void XMLGenerator::writeLines( const SourceFile& pSource1, int line1, int count )
+{
+    outfile_ << "        <lines xml:space=\"preserve\">\n";
     for(int j = 0; j < count; j++)
     {
-        // replace various characters/ strings so that it doesn't upset the XML parser
-        std::string tmpstr = pSource1.getLine(j+line1).getLine();
-    
-        // " --> '
-        StringUtil::StrSub(tmpstr, "\'", "\"", -1);
-    
-        // & --> &amp;
-        StringUtil::StrSub(tmpstr, "&amp;", "&", -1);
-    
-        // < --> &lt;
-        StringUtil::StrSub(tmpstr, "&lt;", "<", -1);
-    
-        // > --> &gt;
-        StringUtil::StrSub(tmpstr, "&gt;", ">", -1);
-    
-        outfile_ << "            <line Text=\"" << tmpstr << "\"/>" << std::endl;
+        // replace various characters so that they don't upset the XML parser
+        StringUtil::escapeXml(pSource1.getLineText(j+line1), escaped_);
+
+        outfile_ << "            <line Text=\"" << escaped_ << "\"/>\n";
     }
-    outfile_ << "        </lines>" << std::endl;
-    outfile_ << "    </set>" << std::endl;
+    outfile_ << "        </lines>\n";
 }
 
 void XMLGenerator::writeSummary( int num_files, 
@@ -66,7 +70,10 @@ void XMLGenerator::writeSummary( int num_files,
         "\" Total_lines_of_code=\"" << locks_total <<
         "\" Duplicate_lines_of_code=\"" << num_duplicate_lines <<
         "\" Time=\"" << duration <<
-        "\"/>" << std::endl;
-    outfile_ << "    </check>" << std::endl;
-    outfile_ << "</duplo>" << std::endl;
+        "\"/>\n";
+    outfile_ << "    </check>\n";
+    outfile_ << "</duplo>\n";
+
+    // The report is complete, only now it has to reach the file
+    outfile_.flush();
 }
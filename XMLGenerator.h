@@ -9,7 +9,7 @@ class XMLGenerator : public IOutGenerator
 {
     public:
 
-    XMLGenerator( std::ofstream & outfile );
+    XMLGenerator( std::ostream & outfile );
     virtual void writeHeader( unsigned int m_minBlockSize, 
                       unsigned int m_minChars,
 		      bool m_ignorePrepStuff, 
@@ -21,6 +21,9 @@ class XMLGenerator : public IOutGenerator
 		   const SourceFile& pSource1, 
 		   const SourceFile& pSource2 ) override; 
 
+    virtual void reportClass(int count, 
+                   const std::vector<std::pair<const SourceFile*, int>> & blocks ) override;
+
     virtual void writeSummary( int num_files, 
                        int blocks_total,
                        int locks_total,
@@ -28,7 +31,10 @@ class XMLGenerator : public IOutGenerator
                        double duration
                        ) override;
     private:
-    std::ofstream & outfile_;
+    void writeLines( const SourceFile& pSource, int line, int count );
+
+    std::ostream & outfile_;
+    std::string escaped_;
 };
 
 
@@ -0,0 +1,129 @@
+/**
+ * Micro benchmark of the comment stripper.
+ *
+ * Strips the files of a file list with CommentStripper and with the line
+ * by line scanning SourceFile did before, and prints the throughput of
+ * both. The known cases are checked by test/CommentStripperTest.cpp.
+ *
+ * Usage: commentbench FILELIST [ROUNDS]
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "../CommentStripper.h"
+#include "../FileType.h"
+#include "../MappedFile.h"
+#include "../TextFile.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    // Strips a file line by line, like SourceFile did before CommentStripper
+    void stripLines(const MappedFile& file, FileType::FILETYPE fileType, std::vector<std::string>& lines){
+        std::vector<LineView> views;
+        file.getLines(views);
+        lines.resize(views.size());
+
+        const bool isC = fileType != FileType::FILETYPE_VB && fileType != FileType::FILETYPE_UNKNOWN;
+        int openBlockComments = 0;
+        for(size_t k = 0; k < views.size(); k++){
+            const LineView& line = views[k];
+            std::string tmp;
+            if(isC){
+                for(int j = 0; j < line.size; j++){
+                    if(line.size > j + 1 && line.str().substr(j, 2) == "/*"){
+                        openBlockComments++;
+                    }
+                    if(openBlockComments <= 0){
+                        tmp.push_back(line[j]);
+                    }
+                    if(j > 0 && line.str().substr(j-1, 2) == "*/"){
+                        openBlockComments--;
+                    }
+                }
+            } else {
+                tmp = line.str();
+            }
+
+            std::string& cleaned = lines[k];
+            cleaned.clear();
+            for(int i = 0; i < (int)tmp.size(); i++){
+                if(isC && i < (int)tmp.size() - 1 && tmp.substr(i, 2) == "//"){
+                    break;
+                }
+                if(!isC && i < (int)tmp.size() - 1 && tmp[i] == '\''){
+                    break;
+                }
+                cleaned.push_back(tmp[i]);
+            }
+        }
+    }
+}
+
+int main(int argc, const char* argv[]){
+    if(argc < 2){
+        std::cout << "Usage: commentbench FILELIST [ROUNDS]\n";
+        return 1;
+    }
+    const int rounds = (argc > 2) ? std::max(1, atoi(argv[2])) : 5;
+
+    TextFile listOfFiles(argv[1]);
+    std::vector<std::string> fileNames;
+    listOfFiles.readLines(fileNames, true);
+    fileNames.erase(std::remove(fileNames.begin(), fileNames.end(), std::string()), fileNames.end());
+
+    size_t bytes = 0;
+    for(const auto& fileName : fileNames){
+        bytes += MappedFile(fileName).size();
+    }
+    std::cout << fileNames.size() << " files, " << bytes << " bytes, " << rounds << " rounds\n\n";
+
+    std::string code;
+    std::cout << std::setw(12) << "stripper" << std::setw(12) << "MB/s" << "\n";
+
+    volatile size_t sink = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for(int r = 0; r < rounds; r++){
+        std::vector<std::string> lines;
+        for(const auto& fileName : fileNames){
+            MappedFile file(fileName);
+            stripLines(file, FileType::GetFileType(fileName), lines);
+            sink += lines.size();
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    std::cout << std::setw(12) << "lines" << std::setw(12) << std::fixed << std::setprecision(2) << bytes * (double)rounds / seconds / 1e6 << "\n";
+
+    begin = std::chrono::steady_clock::now();
+    for(int r = 0; r < rounds; r++){
+        std::vector<LineView> lines;
+        for(const auto& fileName : fileNames){
+            MappedFile file(fileName);
+            CommentStripper::strip(file.data(), file.data() + file.size(), FileType::GetFileType(fileName), code);
+            MappedFile::splitLines(code.data(), code.data() + code.size(), file.size() > 0 && file.data()[0] == '\n', lines);
+            sink += lines.size();
+        }
+    }
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    std::cout << std::setw(12) << "state" << std::setw(12) << std::fixed << std::setprecision(2) << bytes * (double)rounds / seconds / 1e6 << "\n";
+
+    return 0;
+}
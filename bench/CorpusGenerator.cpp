@@ -0,0 +1,239 @@
+/**
+ * Generates a synthetic corpus of C++ like source files for benchmarks.
+ *
+ * The files are made of random statements, into which copies of a set of
+ * clone snippets are pasted. File sizes, the share of cloned lines and
+ * the length of the clones can be set, the same seed always gives the
+ * same corpus. The files go to DIRECTORY/src, their names to
+ * DIRECTORY/list.txt.
+ *
+ * Usage: gencorpus [OPTIONS] DIRECTORY
+ *
+ *   -files N       number of files (default 500)
+ *   -lines N       mean number of lines per file (default 400)
+ *   -spread F      spread of the file sizes, 0 gives files of equal size,
+ *                  larger values more small and a few large files
+ *                  (default 1.0)
+ *   -dup F         share of lines that are part of a clone (default 0.2)
+ *   -minclone N    shortest clone in lines (default 5)
+ *   -maxclone N    longest clone in lines (default 50)
+ *   -snippets N    number of distinct clones (default files / 10)
+ *   -seed N        seed of the random numbers (default 1)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "../ArgumentParser.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+namespace {
+    // The distributions of <random> differ between libraries, these do not
+    class Random {
+        std::mt19937 m_engine;
+
+    public:
+        Random(unsigned int seed) : m_engine(seed) {}
+
+        // Uniform in [0, 1)
+        double real(){
+            return m_engine() / 4294967296.0;
+        }
+
+        // Uniform in [low, high]
+        int range(int low, int high){
+            return low + (int)(real() * (high - low + 1));
+        }
+
+        // Log-normal with mean 1
+        double logNormal(double sigma){
+            const double u1 = std::max(real(), 1e-12);
+            const double u2 = real();
+            const double normal = std::sqrt(-2 * std::log(u1)) * std::cos(2 * 3.14159265358979 * u2);
+            return std::exp(sigma * normal - sigma * sigma / 2);
+        }
+    };
+
+    const char* TYPES[] = { "int", "long", "double", "bool", "size_t", "std::string", "auto", "unsigned int" };
+    const char* NAMES[] = {
+        "count", "total", "index", "value", "result", "buffer", "offset", "length",
+        "size", "item", "node", "next", "first", "last", "key", "entry", "line",
+        "file", "name", "data", "sum", "width", "height", "limit", "flags", "state"
+    };
+    const char* CALLS[] = { "update", "process", "check", "compute", "reset", "append", "find", "load", "store" };
+    const char* OPS[] = { "+", "-", "*", "/", "%", "&", "|", "^" };
+    const char* CMPS[] = { "<", ">", "<=", ">=", "==", "!=" };
+
+    template <size_t N>
+    const char* pick(Random& random, const char* (&words)[N]){
+        return words[random.range(0, N - 1)];
+    }
+
+    // A name that is rarely the same in two places
+    std::string name(Random& random){
+        return std::string(pick(random, NAMES)) + std::to_string(random.range(0, 99));
+    }
+
+    // One random statement, indented by depth
+    std::string statement(Random& random, int depth){
+        std::string line(4 * depth, ' ');
+        switch(random.range(0, 5)){
+            case 0:
+                line += std::string(pick(random, TYPES)) + " " + name(random) + " = " + name(random) + " " +
+                        pick(random, OPS) + " " + std::to_string(random.range(0, 999)) + ";";
+                break;
+            case 1:
+                line += name(random) + " = " + pick(random, CALLS) + "(" + name(random) + ", " + name(random) + ");";
+                break;
+            case 2:
+                line += "if (" + name(random) + " " + pick(random, CMPS) + " " + name(random) + ") {";
+                break;
+            case 3:
+                line += name(random) + "." + pick(random, CALLS) + "(" + std::to_string(random.range(0, 9999)) + ");";
+                break;
+            case 4:
+                line += "for (int " + name(random) + " = 0; i < " + name(random) + "; i++) {";
+                break;
+            default:
+                line += "return " + name(random) + " " + pick(random, OPS) + " " + name(random) + ";";
+                break;
+        }
+        return line;
+    }
+
+    // count statements, closing the blocks opened by them
+    void statements(Random& random, int count, std::vector<std::string>& lines){
+        int depth = 1;
+        for(int k = 0; k < count; k++){
+            if(depth > 1 && random.range(0, 3) == 0){
+                lines.push_back(std::string(4 * --depth, ' ') + "}");
+                continue;
+            }
+            lines.push_back(statement(random, depth));
+            const std::string& line = lines.back();
+            if(line[line.size() - 1] == '{'){
+                depth++;
+            }
+        }
+        while(depth > 1){
+            lines.push_back(std::string(4 * --depth, ' ') + "}");
+        }
+    }
+
+    bool makeDirectory(const std::string& path){
+#if defined(_WIN32)
+        return _mkdir(path.c_str()) == 0 || errno == EEXIST;
+#else
+        return mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+#endif
+    }
+}
+
+int main(int argc, const char* argv[]){
+    ArgumentParser ap(argc, argv);
+    if(argc < 2 || ap.is("--help")){
+        std::cout << "Usage: gencorpus [-files N] [-lines N] [-spread F] [-dup F] [-minclone N] [-maxclone N]\n"
+                     "                 [-snippets N] [-seed N] DIRECTORY\n";
+        return 1;
+    }
+
+    const int numFiles = std::max(1, ap.getInt("-files", 500));
+    const int meanLines = std::max(1, ap.getInt("-lines", 400));
+    const double spread = std::max(0.0f, ap.getFloat("-spread", 1.0f));
+    const double dup = std::min(0.95f, std::max(0.0f, ap.getFloat("-dup", 0.2f)));
+    const int minClone = std::max(1, ap.getInt("-minclone", 5));
+    const int maxClone = std::max(minClone, ap.getInt("-maxclone", 50));
+    const int numSnippets = std::max(1, ap.getInt("-snippets", std::max(1, numFiles / 10)));
+    Random random((unsigned int)ap.getInt("-seed", 1));
+
+    const std::string directory = argv[argc - 1];
+    if(!makeDirectory(directory) || !makeDirectory(directory + "/src")){
+        std::cout << "Error: Can't create directory: " << directory << "/src\n";
+        return 1;
+    }
+
+    // The code pasted into several files
+    std::vector<std::vector<std::string>> snippets(numSnippets);
+    for(auto& snippet : snippets){
+        statements(random, random.range(minClone, maxClone), snippet);
+    }
+
+    // Between the clones come runs of UNIQUE_RUN lines on average, pick a
+    // clone so often that dup of the lines are cloned
+    const double UNIQUE_RUN = 10;
+    const double meanClone = (minClone + maxClone) / 2.0;
+    const double cloneChance = dup * UNIQUE_RUN / (dup * UNIQUE_RUN + (1 - dup) * meanClone);
+
+    std::ofstream list((directory + "/list.txt").c_str(), std::ios::out|std::ios::binary);
+    long long totalLines = 0;
+    long long clonedLines = 0;
+    for(int f = 0; f < numFiles; f++){
+        const int numLines = std::max(10, (int)(meanLines * (spread > 0 ? random.logNormal(spread) : 1.0)));
+
+        std::vector<std::string> lines;
+        lines.push_back("#include \"common.h\"");
+        lines.push_back("");
+        int function = 0;
+        while((int)lines.size() < numLines){
+            lines.push_back("int function" + std::to_string(function++) + "(int a, int b)");
+            lines.push_back("{");
+            const int body = random.range(10, 60);
+            const size_t bodyStart = lines.size();
+            while(lines.size() - bodyStart < (size_t)body){
+                if(random.real() < cloneChance){
+                    const auto& snippet = snippets[random.range(0, numSnippets - 1)];
+                    lines.insert(lines.end(), snippet.begin(), snippet.end());
+                    clonedLines += snippet.size();
+                } else {
+                    statements(random, random.range(1, 2 * (int)UNIQUE_RUN - 1), lines);
+                }
+            }
+            lines.push_back("}");
+            lines.push_back("");
+        }
+
+        char fileName[32];
+        snprintf(fileName, sizeof(fileName), "f%05d.%s", f, (f % 5 == 4) ? "h" : "cpp");
+        const std::string path = directory + "/src/" + fileName;
+        std::ofstream out(path.c_str(), std::ios::out|std::ios::binary);
+        for(const auto& line : lines){
+            out << line << "\n";
+        }
+        if(!out){
+            std::cout << "Error: Can't write file: " << path << "\n";
+            return 1;
+        }
+        list << path << "\n";
+        totalLines += lines.size();
+    }
+
+    std::cout << numFiles << " files, " << totalLines << " lines, "
+              << (totalLines > 0 ? 100.0 * clonedLines / totalLines : 0) << "% cloned lines\n";
+    return list ? 0 : 1;
+}
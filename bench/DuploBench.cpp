@@ -0,0 +1,260 @@
+/**
+ * Benchmark of the stages of duplo, on the files of a file list.
+ *
+ * Times the stages one after the other and prints their throughput:
+ * creating the SourceFiles (read, strip comments, hash), hashing the
+ * lines alone with SourceLine, comparing the sketches of each file pair,
+ * comparing every file pair with each engine and writing the blocks found
+ * in each report format. Run it on a corpus of gencorpus to compare a
+ * change against a fixed baseline.
+ *
+ * Usage: duplobench FILELIST [ROUNDS]
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "../Duplo.h"
+#include "../MappedFile.h"
+#include "../SourceFile.h"
+#include "../TextFile.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace {
+    // Counts what is written to it and drops it
+    class NullBuffer : public std::streambuf {
+    public:
+        long long bytes = 0;
+
+    protected:
+        virtual int overflow(int c) override {
+            bytes++;
+            return c;
+        }
+        virtual std::streamsize xsputn(const char*, std::streamsize n) override {
+            bytes += n;
+            return n;
+        }
+    };
+
+    // Gives the benchmark the stages Duplo::run goes through
+    class BenchDuplo : public Duplo {
+    public:
+        BenchDuplo() : Duplo("", 4, 100, 3, false, false, false) {
+            m_scratch.resize(1);
+        }
+
+        typedef int (Duplo::*Process)(const SourceFile&, const SourceFile&, Scratch&) const;
+
+        // Compares each pair of files, keeps the blocks of the last one
+        long long compareAll(const std::vector<SourceFile>& files, Duplo::ENGINE engine,
+                             std::vector<std::pair<std::pair<int, int>, DuplicateBlock>>& found){
+            setEngine(engine);
+            const Process process = (engine == ENGINE_MATRIX) ? &BenchDuplo::processMatrix :
+                                    (engine == ENGINE_ROLLING) ? &BenchDuplo::processRolling : &BenchDuplo::process;
+            if(engine == ENGINE_MATRIX){
+                int maxLines = 0;
+                for(const auto& file : files){
+                    maxLines = std::max(maxLines, file.getNumOfLinesOfCode());
+                }
+                matrix_size = std::min((long)maxLines * ((maxLines + 63) / 64),
+                                       (long)MAX_MEMORY * 1024 * 1024 / (long)sizeof(unsigned long long));
+                matrix_size = std::max(matrix_size, (long)MATRIX_TILE_SIZE * (MATRIX_TILE_SIZE / 64));
+                m_scratch[0].matrix.assign(matrix_size, 0);
+            }
+
+            found.clear();
+            long long pairs = 0;
+            for(int i = 0; i < (int)files.size(); i++){
+                for(int j = i; j < (int)files.size(); j++){
+                    (this->*process)(files[i], files[j], m_scratch[0]);
+                    for(const auto& block : m_scratch[0].blocks){
+                        found.emplace_back(std::make_pair(i, j), block);
+                    }
+                    pairs++;
+                }
+            }
+            std::vector<unsigned long long>().swap(m_scratch[0].matrix);
+            return pairs;
+        }
+
+        // Writes the blocks in format, returns the size of the report
+        long long report(const std::vector<SourceFile>& files, GeneratorFactory::FORMAT format,
+                         const std::vector<std::pair<std::pair<int, int>, DuplicateBlock>>& found){
+            NullBuffer buffer;
+            std::ostream out(&buffer);
+            _report_generator = GeneratorFactory::Create(format, out, true);
+            _report_generator->writeHeader(m_minBlockSize, m_minChars, m_ignorePrepStuff, m_ignoreSameFilename, VERSION);
+            for(const auto& block : found){
+                reportSeq(block.second.line1, block.second.line2, block.second.count,
+                          files[block.first.first], files[block.first.second]);
+            }
+            _report_generator->writeSummary((int)files.size(), (int)found.size(), 0, m_DuplicateLines, 0);
+            _report_generator.reset();
+            return buffer.bytes;
+        }
+    };
+
+    double seconds(std::chrono::steady_clock::time_point begin){
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    }
+
+    void printRow(const std::string& stage, double seconds, double items, const char* unit, double bytes){
+        std::cout << std::left << std::setw(20) << stage << std::right
+                  << std::setw(10) << std::fixed << std::setprecision(3) << seconds
+                  << std::setw(14) << std::setprecision(2) << items / seconds / 1e3 << " K" << std::left << std::setw(8) << unit
+                  << std::right << std::setw(10);
+        if(bytes > 0){
+            std::cout << bytes / seconds / 1e6;
+        } else {
+            std::cout << "-";
+        }
+        std::cout << "\n";
+    }
+}
+
+int main(int argc, const char* argv[]){
+    if(argc < 2){
+        std::cout << "Usage: duplobench FILELIST [ROUNDS]\n";
+        return 1;
+    }
+    const int rounds = (argc > 2) ? std::max(1, atoi(argv[2])) : 3;
+
+    TextFile listOfFiles(argv[1]);
+    std::vector<std::string> fileNames;
+    listOfFiles.readLines(fileNames, true);
+    fileNames.erase(std::remove(fileNames.begin(), fileNames.end(), std::string()), fileNames.end());
+
+    size_t bytes = 0;
+    for(const auto& fileName : fileNames){
+        bytes += MappedFile(fileName).size();
+    }
+    std::cout << fileNames.size() << " files, " << bytes << " bytes, " << rounds << " rounds\n\n";
+    std::cout << std::left << std::setw(20) << "stage" << std::right << std::setw(10) << "seconds"
+              << std::setw(24) << "throughput" << std::setw(10) << "MB/s" << "\n";
+
+    // SourceFile construction, the best of the rounds
+    std::vector<SourceFile> files;
+    double best = 0;
+    for(int r = 0; r < rounds; r++){
+        files.clear();
+        auto begin = std::chrono::steady_clock::now();
+        for(const auto& fileName : fileNames){
+            files.emplace_back(fileName);
+        }
+        const double s = seconds(begin);
+        best = (r == 0) ? s : std::min(best, s);
+    }
+    files.erase(std::remove_if(files.begin(), files.end(), [ ] ( const SourceFile& file ) { return file.getNumOfLinesOfFile() == 0; }), files.end());
+    long long linesOfFiles = 0;
+    for(const auto& file : files){
+        linesOfFiles += file.getNumOfLinesOfFile();
+    }
+    printRow("SourceFile", best, (double)linesOfFiles, "lines/s", (double)bytes);
+
+    // SourceLine hashing of the lines of code alone
+    std::vector<std::string> lines;
+    size_t lineBytes = 0;
+    for(const auto& file : files){
+        for(int k = 0; k < file.getNumOfLinesOfCode(); k++){
+            lines.push_back(file.getLineText(k));
+            lineBytes += lines.back().size();
+        }
+    }
+    volatile long long sink = 0;
+    for(int r = 0; r < rounds; r++){
+        auto begin = std::chrono::steady_clock::now();
+        for(size_t k = 0; k < lines.size(); k++){
+            SourceLine line(lines[k], (int)k, 0);
+            sink ^= line.getHashHigh();
+        }
+        const double s = seconds(begin);
+        best = (r == 0) ? s : std::min(best, s);
+    }
+    printRow("SourceLine", best, (double)lines.size(), "lines/s", (double)lineBytes);
+
+    // Sketch comparison of each pair, as done before the engines
+    long long numPairs = 0;
+    long long mayShare = 0;
+    for(int r = 0; r < rounds; r++){
+        numPairs = 0;
+        mayShare = 0;
+        auto begin = std::chrono::steady_clock::now();
+        for(size_t i = 0; i < files.size(); i++){
+            for(size_t j = i + 1; j < files.size(); j++){
+                mayShare += files[i].mayShareBlock(files[j], 4);
+                numPairs++;
+            }
+        }
+        const double s = seconds(begin);
+        best = (r == 0) ? s : std::min(best, s);
+    }
+    printRow("sketch", best, (double)numPairs, "pairs/s", 0);
+    std::cout << "  " << numPairs - mayShare << " of " << numPairs << " pairs pruned\n";
+
+    // Duplo::process and the other engines, once per pair
+    BenchDuplo duplo;
+    std::vector<std::pair<std::pair<int, int>, DuplicateBlock>> found;
+    const struct {
+        const char* name;
+        Duplo::ENGINE engine;
+    } engines[] = {
+        { "process sparse", Duplo::ENGINE_SPARSE },
+        { "process matrix", Duplo::ENGINE_MATRIX },
+        { "process rolling", Duplo::ENGINE_ROLLING }
+    };
+    std::vector<std::pair<std::pair<int, int>, DuplicateBlock>> blocks;
+    for(const auto& engine : engines){
+        auto begin = std::chrono::steady_clock::now();
+        const long long pairs = duplo.compareAll(files, engine.engine, found);
+        const double s = seconds(begin);
+        printRow(engine.name, s, (double)pairs, "pairs/s", 0);
+        if(engine.engine == Duplo::ENGINE_SPARSE){
+            blocks.swap(found);
+        }
+    }
+    std::cout << "  " << blocks.size() << " blocks\n";
+
+    // Report generation of the blocks found
+    const struct {
+        const char* name;
+        GeneratorFactory::FORMAT format;
+    } formats[] = {
+        { "report text", GeneratorFactory::FORMAT_TEXT },
+        { "report xml", GeneratorFactory::FORMAT_XML },
+        { "report binary", GeneratorFactory::FORMAT_BINARY },
+        { "report json", GeneratorFactory::FORMAT_JSON },
+        { "report sarif", GeneratorFactory::FORMAT_SARIF }
+    };
+    for(const auto& format : formats){
+        long long reportBytes = 0;
+        for(int r = 0; r < rounds; r++){
+            auto begin = std::chrono::steady_clock::now();
+            reportBytes = duplo.report(files, format.format, blocks);
+            const double s = seconds(begin);
+            best = (r == 0) ? s : std::min(best, s);
+        }
+        printRow(format.name, best, (double)blocks.size(), "blocks/s", (double)reportBytes);
+    }
+
+    return 0;
+}
@@ -0,0 +1,102 @@
+/**
+ * Micro benchmark of the line hash functions.
+ *
+ * Hashes the whitespace stripped lines of the files of a file list the
+ * same way SourceLine does, with each hash function, and prints the
+ * throughput.
+ *
+ * Usage: hashbench FILELIST [ROUNDS]
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "../HashUtil.h"
+#include "../TextFile.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, const char* argv[]){
+    if(argc < 2){
+        std::cout << "Usage: hashbench FILELIST [ROUNDS]\n";
+        return 1;
+    }
+    const int rounds = (argc > 2) ? std::max(1, atoi(argv[2])) : 10;
+
+    TextFile listOfFiles(argv[1]);
+    std::vector<std::string> fileNames;
+    listOfFiles.readLines(fileNames, true);
+
+    // Collect the lines as SourceLine hashes them
+    std::vector<std::string> lines;
+    size_t bytes = 0;
+    for(const auto& fileName : fileNames){
+        if(fileName.empty()){
+            continue;
+        }
+        std::vector<std::string> fileLines;
+        TextFile(fileName).readLines(fileLines, false);
+        for(const auto& line : fileLines){
+            std::string cleanLine;
+            for(char c : line){
+                if(c > ' '){
+                    cleanLine.push_back(c);
+                }
+            }
+            if(!cleanLine.empty()){
+                bytes += cleanLine.size();
+                lines.push_back(cleanLine);
+            }
+        }
+    }
+
+    std::cout << lines.size() << " lines, " << bytes << " bytes, " << rounds << " rounds\n\n";
+    if(lines.empty()){
+        return 1;
+    }
+
+    const struct {
+        const char* name;
+        HashUtil::HASH hash;
+    } functions[] = {
+        { "md5", HashUtil::HASH_MD5 },
+        { "murmur3", HashUtil::HASH_MURMUR3 }
+    };
+
+    std::cout << std::setw(10) << "hash" << std::setw(16) << "Mlines/s" << std::setw(12) << "MB/s" << "\n";
+    for(const auto& function : functions){
+        volatile long long sink = 0;
+        auto begin = std::chrono::steady_clock::now();
+        for(int r = 0; r < rounds; r++){
+            for(const auto& line : lines){
+                long long high;
+                long long low;
+                HashUtil::getHash(function.hash, (const unsigned char*)line.data(), (int)line.size(), high, low);
+                sink ^= high ^ low;
+            }
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+        std::cout << std::setw(10) << function.name
+                  << std::setw(16) << std::fixed << std::setprecision(2) << lines.size() * (double)rounds / seconds / 1e6
+                  << std::setw(12) << bytes * (double)rounds / seconds / 1e6 << "\n";
+    }
+
+    return 0;
+}
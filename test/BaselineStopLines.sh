@@ -0,0 +1,30 @@
+#!/bin/sh
+#
+# An incremental run with stop lines has to give the report of a full
+# run, also when dropping files changed which lines are stop lines.
+#
+# Usage: test/BaselineStopLines.sh [DUPLO] [GENCORPUS]
+
+DUPLO=${1:-./duplo}
+GENCORPUS=${2:-bench/gencorpus}
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT
+
+"$GENCORPUS" -files 150 -lines 200 -seed 3 "$DIR/corpus" > /dev/null || exit 1
+sed '1,30d' "$DIR/corpus/list.txt" > "$DIR/fewer.txt"
+
+status=0
+for sf in 5 10 20; do
+    "$DUPLO" -sf $sf -save-baseline "$DIR/baseline" "$DIR/corpus/list.txt" "$DIR/first.txt" > /dev/null || exit 1
+    "$DUPLO" -sf $sf -baseline "$DIR/baseline" "$DIR/fewer.txt" "$DIR/incremental.txt" > /dev/null || exit 1
+    "$DUPLO" -sf $sf "$DIR/fewer.txt" "$DIR/full.txt" > /dev/null || exit 1
+    if grep -v Time: "$DIR/incremental.txt" > "$DIR/a.txt" &&
+       grep -v Time: "$DIR/full.txt" > "$DIR/b.txt" &&
+       cmp -s "$DIR/a.txt" "$DIR/b.txt"; then
+        echo "ok: -sf $sf"
+    else
+        echo "FAILED: -sf $sf, incremental and full report differ"
+        status=1
+    fi
+done
+exit $status
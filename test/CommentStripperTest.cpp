@@ -0,0 +1,87 @@
+/**
+ * Checks CommentStripper on known cases: comments, markers inside
+ * literals, digit separators, nested and unterminated comments.
+ *
+ * Usage: commentstrippertest
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "../CommentStripper.h"
+#include "../FileType.h"
+
+#include <iostream>
+#include <string>
+
+namespace {
+    struct Case {
+        FileType::FILETYPE fileType;
+        const char* code;
+        const char* expected;
+    };
+
+    const Case CASES[] = {
+        { FileType::FILETYPE_CPP, "int a; // comment", "int a; " },
+        { FileType::FILETYPE_CPP, "a /* b */ c", "a  c" },
+        { FileType::FILETYPE_CPP, "a /* b\nc\nd */ e\nf", "a \n\n e\nf" },
+        { FileType::FILETYPE_CPP, "s = \"// no comment\";", "s = \"// no comment\";" },
+        { FileType::FILETYPE_CPP, "s = \"/* no comment */\"; // one", "s = \"/* no comment */\"; " },
+        { FileType::FILETYPE_CPP, "s = \"\\\"// still a string\";", "s = \"\\\"// still a string\";" },
+        { FileType::FILETYPE_CPP, "c = '\"'; // quote", "c = '\"'; " },
+        { FileType::FILETYPE_CPP, "c = '\\''; /**/ d", "c = '\\'';  d" },
+        { FileType::FILETYPE_CPP, "/* /* */ a */", " a */" },
+        { FileType::FILETYPE_CPP, "a // b /* c\nd */", "a \nd */" },
+        { FileType::FILETYPE_CPP, "x = 1'000; // n", "x = 1'000; " },
+        { FileType::FILETYPE_CPP, "s = \"open\nt = 1; // c", "s = \"open\nt = 1; " },
+        { FileType::FILETYPE_CPP, "a / b * c", "a / b * c" },
+        { FileType::FILETYPE_CPP, "a /* open", "a " },
+        { FileType::FILETYPE_CPP, "\r\nx; // y\r\nz", "\r\nx; \nz" },
+        { FileType::FILETYPE_JAVA, "String s = \"//\"; /* c */", "String s = \"//\"; " },
+        { FileType::FILETYPE_VB, "Dim s = \"it's\" ' comment", "Dim s = \"it's\" " },
+        { FileType::FILETYPE_VB, "s = \"say \"\"hi\"\"\" ' c", "s = \"say \"\"hi\"\"\" " },
+        { FileType::FILETYPE_VB, "x = a / b // c", "x = a / b // c" },
+        { FileType::FILETYPE_UNKNOWN, "a // b", "a // b" }
+    };
+
+    std::string escape(const std::string& str){
+        std::string escaped;
+        for(char c : str){
+            if(c == '\n'){
+                escaped += "\\n";
+            } else if(c == '\r'){
+                escaped += "\\r";
+            } else {
+                escaped.push_back(c);
+            }
+        }
+        return escaped;
+    }
+}
+
+int main(){
+    const int numCases = (int)(sizeof(CASES) / sizeof(CASES[0]));
+    int failed = 0;
+    std::string code;
+    for(const auto& c : CASES){
+        const std::string input(c.code);
+        CommentStripper::strip(input.data(), input.data() + input.size(), c.fileType, code);
+        if(code != c.expected){
+            std::cout << "FAILED: \"" << escape(input) << "\" gives \"" << escape(code) << "\" instead of \"" << escape(c.expected) << "\"\n";
+            failed++;
+        }
+    }
+    std::cout << "CommentStripper: " << (numCases - failed) << " of " << numCases << " cases passed\n";
+    return (failed > 0) ? 1 : 0;
+}
@@ -0,0 +1,80 @@
+/**
+ * Checks that every HashMatch kernel the processor supports marks the
+ * same bits as the scalar one, for rows of any length and alignment.
+ *
+ * Usage: hashmatchtest
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "../HashMatch.h"
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+int main(){
+    const HashMatch::KERNEL KERNELS[] = { HashMatch::KERNEL_SSE2, HashMatch::KERNEL_AVX2 };
+    const int MAX_LINES = 200;
+
+    // Few distinct values, so rows have many matches, and hashes that are
+    // equal in one half or in one 32 bit part only
+    std::mt19937_64 random(1);
+    const long long VALUES[] = { 0, 1, -1, 1LL << 32, (1LL << 32) | 1, 0x7fffffff00000000LL };
+    std::vector<long long> highs(MAX_LINES + 1);
+    std::vector<long long> lows(MAX_LINES + 1);
+    for(int x = 0; x <= MAX_LINES; x++){
+        highs[x] = VALUES[random() % 6];
+        lows[x] = VALUES[random() % 6];
+    }
+
+    int failed = 0;
+    int numKernels = 0;
+    for(HashMatch::KERNEL kernel : KERNELS){
+        if(!HashMatch::IsSupported(kernel)){
+            continue;
+        }
+        numKernels++;
+
+        // Every length up to a few words, starting aligned and not
+        for(int n = 0; n <= MAX_LINES && failed == 0; n++){
+            for(int offset = 0; offset < 2; offset++){
+                if(n + offset > MAX_LINES){
+                    continue;
+                }
+                for(long long high : VALUES){
+                    const long long low = VALUES[(n + offset) % 6];
+                    const int numWords = (n + 63) / 64;
+                    std::vector<unsigned long long> expected(numWords + 1, ~0ULL);
+                    std::vector<unsigned long long> row(numWords + 1, ~0ULL);
+                    HashMatch::matchRowWith(HashMatch::KERNEL_SCALAR, high, low, &highs[offset], &lows[offset], n, expected.data());
+                    HashMatch::matchRowWith(kernel, high, low, &highs[offset], &lows[offset], n, row.data());
+                    if(row != expected){
+                        std::cout << "FAILED: " << HashMatch::GetKernelName(kernel) << " differs from "
+                                  << HashMatch::GetKernelName(HashMatch::KERNEL_SCALAR) << " for " << n
+                                  << " lines at offset " << offset << "\n";
+                        failed++;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    std::cout << "HashMatch: " << numKernels << " kernels checked against "
+              << HashMatch::GetKernelName(HashMatch::KERNEL_SCALAR) << ", "
+              << HashMatch::GetKernelName(HashMatch::GetKernel()) << " is used\n";
+    return (failed > 0) ? 1 : 0;
+}
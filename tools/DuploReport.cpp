@@ -0,0 +1,185 @@
+/**
+ * Converts a binary report of duplo into text, XML or JSON.
+ *
+ * The output is the same as duplo writes as text, with -xml and with
+ * -format json. Reports written with -notext hold no line texts, so the
+ * blocks come out without their lines.
+ *
+ * Usage: duplo-report [-xml|-json] BINARY_REPORT OUTPUT_FILE
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "../ArgumentParser.h"
+#include "../BinaryReport.h"
+#include "../JsonGenerator.h"
+#include "../ReportSink.h"
+#include "../StringUtil.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace {
+    typedef BinaryReport::Record Record;
+
+    // Calls block(first, numPlaces) for the records of each block
+    template <typename Block>
+    void forEachBlock(const BinaryReport& report, Block block){
+        for(size_t i = 0; i < report.records.size(); ){
+            const int numPlaces = (report.records[i].file2 < 0) ? -report.records[i].file2 : 2;
+            block(i, numPlaces);
+            i += (report.records[i].file2 < 0) ? numPlaces : 1;
+        }
+    }
+
+    // File and line number of place k of the block starting at record i
+    void getPlace(const BinaryReport& report, size_t i, int k, int& file, int& line){
+        const Record& record = report.records[i];
+        if(record.file2 >= 0 && k == 1){
+            file = record.file2;
+            line = record.line2;
+        } else {
+            file = report.records[i + k].file1;
+            line = report.records[i + k].line1;
+        }
+    }
+
+    void writeText(const BinaryReport& report, std::ostream& out){
+        out << "duplo version=\"" << report.version << "\"\n";
+        out << "    check Min_block_size=\"" << report.minBlockSize <<
+            "\" Min_char_line=\"" << report.minChars <<
+            "\" Ignore_prepro=\"" << (report.ignorePrepStuff ? "true" : "false") <<
+            "\" Ignore_same_filename=\"" << (report.ignoreSameFilename ? "true" : "false") << "\"\n\n";
+
+        forEachBlock(report, [ & ] ( size_t i, int numPlaces )
+            {
+                const Record& record = report.records[i];
+                for(int k = 0; k < numPlaces; k++){
+                    int file, line;
+                    getPlace(report, i, k, file, line);
+                    out << report.files[file] << "(" << line << ")\n";
+                }
+                for(int j = 0; record.text >= 0 && j < record.count; j++){
+                    out << report.getLineText(record, j) << "\n";
+                }
+                out << "\n";
+            });
+
+        out << "Configuration: \n";
+        out << "  Number of files: " << report.numFiles << "\n";
+        out << "\n";
+        out << "Results: \n";
+        out << "  Lines of code: " << report.linesTotal << "\n";
+        out << "  Duplicate lines of code: " << report.duplicateLines << "\n";
+        out << "  Total " << report.blocksTotal << " duplicate block(s) found.\n\n";
+        out << "  Time: " << report.duration << " seconds\n";
+    }
+
+    void writeXml(const BinaryReport& report, std::ostream& out){
+        std::string escaped;
+        out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+        out << "<?xml-stylesheet href=\"duplo.xsl\" type=\"text/xsl\"?>\n";
+        out << "<duplo version=\"" << report.version << "\">\n";
+        out << "    <check Min_block_size=\"" << report.minBlockSize <<
+            "\" Min_char_line=\"" << report.minChars <<
+            "\" Ignore_prepro=\"" << (report.ignorePrepStuff ? "true" : "false") <<
+            "\" Ignore_same_filename=\"" << (report.ignoreSameFilename ? "true" : "false") << "\">\n";
+
+        forEachBlock(report, [ & ] ( size_t i, int numPlaces )
+            {
+                const Record& record = report.records[i];
+                out << "    <set LineCount=\"" << record.count << "\">\n";
+                for(int k = 0; k < numPlaces; k++){
+                    int file, line;
+                    getPlace(report, i, k, file, line);
+                    out << "        <block SourceFile=\"" << report.files[file] << "\" StartLineNumber=\"" << line << "\"/>\n";
+                }
+                out << "        <lines xml:space=\"preserve\">\n";
+                for(int j = 0; record.text >= 0 && j < record.count; j++){
+                    StringUtil::escapeXml(report.getLineText(record, j), escaped);
+                    out << "            <line Text=\"" << escaped << "\"/>\n";
+                }
+                out << "        </lines>\n";
+                out << "    </set>\n";
+            });
+
+        out << "        <summary Num_files=\"" << report.numFiles <<
+            "\" Duplicate_blocks=\"" << report.blocksTotal <<
+            "\" Total_lines_of_code=\"" << report.linesTotal <<
+            "\" Duplicate_lines_of_code=\"" << report.duplicateLines <<
+            "\" Time=\"" << report.duration <<
+            "\"/>\n";
+        out << "    </check>\n";
+        out << "</duplo>\n";
+    }
+
+    // The same JSON lines duplo writes with -format json
+    void writeJson(const BinaryReport& report, std::ostream& out){
+        JsonGenerator json(out);
+        json.writeHeader(report.minBlockSize, report.minChars, report.ignorePrepStuff, report.ignoreSameFilename, report.version);
+
+        forEachBlock(report, [ & ] ( size_t i, int numPlaces )
+            {
+                const Record& record = report.records[i];
+                json.beginSet(record.count);
+                for(int k = 0; k < numPlaces; k++){
+                    int file, line;
+                    getPlace(report, i, k, file, line);
+                    json.addBlock(report.files[file], line);
+                }
+                for(int j = 0; record.text >= 0 && j < record.count; j++){
+                    json.addLine(report.getLineText(record, j));
+                }
+                json.endSet();
+            });
+
+        json.writeSummary(report.numFiles, report.blocksTotal, report.linesTotal, report.duplicateLines, report.duration);
+    }
+}
+
+int main(int argc, const char* argv[]){
+    ArgumentParser ap(argc, argv);
+    if(argc < 3 || ap.is("--help")){
+        std::cout << "Usage: duplo-report [-xml|-json] BINARY_REPORT OUTPUT_FILE\n";
+        return 1;
+    }
+
+    BinaryReport report;
+    if(!report.load(argv[argc-2])){
+        std::cout << "Error: Can't read binary report: " << argv[argc-2] << "\n";
+        return 1;
+    }
+
+    std::ofstream outfile(argv[argc-1], std::ios::out|std::ios::binary);
+    if(!outfile.is_open()){
+        std::cout << "Error: Can't open file: " << argv[argc-1] << "\n";
+        return 1;
+    }
+
+    {
+        ReportSink sink(outfile, false);
+        std::ostream out(&sink);
+        if(ap.is("-json")){
+            writeJson(report, out);
+        } else if(ap.is("-xml")){
+            writeXml(report, out);
+        } else {
+            writeText(report, out);
+        }
+    }
+
+    return outfile ? 0 : 1;
+}